@@ -1,11 +1,19 @@
 #include <stdio.h> // Biblioteca padrão da linguagem C
 #include "pico/stdlib.h" // Subconjunto central de bibliotecas do SDK Pico
-#include "hardware/pio.h" // Biblioteca para controle do PIO utilizado para controle da Matriz de LEDs 5x5
-#include "matriz.pio.h" // Arquivo .pio que contém a definição do programa
 #include "hardware/i2c.h" // Biblioteca para controle da comunicação I2C
+#include "include/hal.h" // Camada de abstração de hardware (implementada em hal_rp2040.c)
 #include "include/ssd1306.h" // Biblioteca para controle do display OLED
-#include "hardware/adc.h" // Biblioteca para controle da conversão ADC
-#include "hardware/pwm.h" // Biblioteca para controle do PWM
+#include "include/matriz_leds.h" // Quadro da matriz de LEDs com correção gama e envio via DMA
+#include "include/sensores.h" // Aquisição contínua dos sensores via ADC round-robin e DMA
+#include "include/agenda.h" // Escalonador cooperativo de tarefas
+#include "pico/multicore.h" // Núcleo 1 dedicado a display, LEDs e telemetria
+#include "include/buzzer.h" // Sequenciador de tons do buzzer via PWM e alarme de hardware
+#include "include/energia.h" // Modo economia e residência por estado de energia
+#include "include/jardim.h" // Lógica da aplicação: controle da rega, alerta, display e telemetria
+#include "include/botoes.h" // Fila de bordas dos botões e eventos de toque, toque longo e repetição
+#include "include/agua.h" // Vazão da bomba e nível do reservatório: água por rega e bomba a seco
+#include "include/zonas.h" // Tabela de zonas de irrigação: sensor, relé, ideal e tempo de rega
+#include "include/rede.h" // Rede RS-485 entre placas: consultas do coordenador e vez da bomba
 #include "pico/bootrom.h" // A ser retirado, permanece durante o periodo de desenvolvimento
 
 // Definição dos pinos utilizados para entradas
@@ -14,9 +22,16 @@
 #define Bot_Confirm 22
 #define Sensor_Luz 26
 #define Sensor_Umidade 27
+#define Sensor_Mux 28 // Saída do multiplexador das zonas extras
+#define Sensor_Vazao 4 // Pulsos do sensor de vazão na saída da bomba (contados pelo pio1)
+#define Sensor_Nivel 3 // Boia de nível mínimo do reservatório (fechada = há água)
 
 // Definição dos pinos utilizados para entradas
 #define Matriz 7
+// Fitas ou painéis WS2812 em paralelo, nos pinos Matriz, Matriz + 1, ... (até 8). Com os pinos
+// abaixo o GPIO 8 é da UART com a rede ligada e o 12 é do relé: para mais fitas, mude Matriz para
+// um bloco livre (GPIO 19-20 com duas, 10-11 sem os relés de exemplo). A sobreposição não compila.
+#define Matriz_Fitas 1
 #define Buzzer 21
 #define Relay 12
 
@@ -25,198 +40,110 @@
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define address 0x3C
+#define Display_Rolagem false // Gráfico rolado no buffer, em qualquer display; true só com SSD1306B ou SSD1315 (comando 0x2D)
 ssd1306_t ssd; // Inicializa a estrutura do display para todas as funções
 
-// Definição de strings para exibição no display
-char str_luz[7], str_umid[7], str_ideal[5], str_rega[4];
-
-// Variáveis de controle com botões
-int8_t ideal = 50 ; // Valor ideal de umidade do solo, inicializado em 50%
-int8_t tempo_rega = 5; // Tempo de rega, inicializado em 5s
-
-// Variáveis de controle do alerta
-#define Alerta_ms 3000  // Tempo do alerta (ms)
-volatile bool evento = false;  // Estado do evento para acionamento do buzzer
-uint slice_num; // Número do slice do PWM
-
-// Variáveis de controle da conversão ADC
-uint16_t adc_value_luz, adc_value_umidade; // Valores lidos dos sensores de luminosidade e umidade do solo
-double umidade; // Variável para armazenar o valor de umidade do solo
-
-// Variáveis Globais para permitir a função de saída da matriz de LEDs
-PIO pio;
-uint sm;
-double intensidade = 0.5; // Intensidade inicial da matriz de LEDs, irá variar de acordo com a luminosidade do ambiente
-
-// Variável para debounce dos botões
-static volatile uint32_t last_time = 0; // Armazena o tempo do último evento (em microssegundos)
-
-// Função de definição de dados para Matriz de LEDs
-uint32_t matrix_rgb (double r, double g, double b) {
-    unsigned char R, G, B;
-    R = r * 255;
-    G = g * 255;
-    B = b * 255;
-    return (G << 24) | (R << 16) | (B << 8);
-}
-
-// Função de acionamento da Matriz de LEDs
-void desenho () {
-    uint32_t valor_led;
-    for (int16_t i = 0; i < 25; i++) {
-        valor_led = matrix_rgb(intensidade, intensidade, intensidade-0.05);
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-}
-
-//Rotinas de Interrupção dos Botões
+// ADC I2C das zonas (ZONAS_I2C) no conector I2C0
+#define I2C_ZONAS_SDA 0
+#define I2C_ZONAS_SCL 1
+
+// Rede RS-485 entre placas (rede.h): uart1 ligado a um transceptor MAX485 (/RE junto do DE). Com a
+// rede ligada os GPIO 8 e 9 ficam com a UART: use outros relés nas zonas de exemplo abaixo.
+// Uma placa do barramento é o coordenador (Rede_Nos, com Rede_Endereco 0) e as demais são nós.
+#define Rede_Endereco 0 // Endereço desta placa no barramento (1 a REDE_NOS_MAX); 0 = sem rede, rega sozinha
+#define Rede_Nos 0 // Coordenador: esta placa consulta os nós 1 a Rede_Nos; 0 = não coordena
+#define Rede_Bombas 1 // Bombas dos nós ligadas ao mesmo tempo; a do coordenador fica fora da conta
+#define Rede_TX 8
+#define Rede_RX 9
+#define Rede_DE 2 // Liga o transmissor do MAX485 só durante os envios
+#define Rede_Ligada (Rede_Endereco || Rede_Nos)
+
+// Os pinos das fitas não podem ter outra função: o PIO da matriz os tomaria sem aviso
+#define Nas_Fitas(p) ((p) >= Matriz && (p) < Matriz + Matriz_Fitas)
+_Static_assert(Matriz_Fitas >= 1 && Matriz_Fitas <= MATRIZ_FITAS_MAX, "Matriz_Fitas: de 1 a MATRIZ_FITAS_MAX");
+_Static_assert(!Nas_Fitas(Bot_Left) && !Nas_Fitas(Bot_Right) && !Nas_Fitas(Bot_Confirm) && !Nas_Fitas(Sensor_Luz) &&
+               !Nas_Fitas(Sensor_Umidade) && !Nas_Fitas(Sensor_Mux) && !Nas_Fitas(Sensor_Vazao) &&
+               !Nas_Fitas(Sensor_Nivel) && !Nas_Fitas(Buzzer) && !Nas_Fitas(Relay) && !Nas_Fitas(I2C_SDA) &&
+               !Nas_Fitas(I2C_SCL) && !Nas_Fitas(I2C_ZONAS_SDA) && !Nas_Fitas(I2C_ZONAS_SCL) &&
+               !Nas_Fitas(ZONAS_MUX_PINO_A) && !Nas_Fitas(ZONAS_MUX_PINO_B) && !Nas_Fitas(ZONAS_MUX_PINO_C),
+               "Matriz .. Matriz + Matriz_Fitas - 1 cobre um pino ja usado");
+_Static_assert(!(Rede_Endereco && Rede_Nos) && Rede_Nos <= REDE_NOS_MAX && Rede_Bombas >= 1,
+               "Rede: a placa e no (Rede_Endereco) ou coordenador (Rede_Nos de 1 a REDE_NOS_MAX), nunca os dois");
+_Static_assert(!Rede_Ligada || (!Nas_Fitas(Rede_TX) && !Nas_Fitas(Rede_RX) && !Nas_Fitas(Rede_DE)),
+               "Matriz .. Matriz + Matriz_Fitas - 1 cobre um pino da rede");
+
+// Zonas de irrigação: um vaso por linha. Zonas extras leem a umidade pelo multiplexador (ZONA_MUX,
+// pinos de seleção em zonas.h) ou pelo ADS1115 (ZONA_I2C) e cada uma aciona a válvula ou bomba do
+// seu relé; as regas se alternam, nunca duas ao mesmo tempo.
+static const zona_config_t zonas[] = {
+    {"Vaso", ZONA_ADC, SENSOR_CANAL_UMIDADE, Relay, 50, 5},
+    // {"Bancada 1", ZONA_MUX, 0, 8, 50, 5},
+    // {"Bancada 2", ZONA_MUX, 1, 9, 60, 10},
+    // {"Bancada 3", ZONA_I2C, 0, 10, 40, 5},
+};
+
+// Rotina de interrupção dos botões (bordas de descida e de subida): só registra a borda com o nível
+// do pino; debounce, toque longo, repetição e os ajustes ficam com o núcleo 0 (botoes.h, jardim.c)
 void gpio_irq_handler(uint gpio, uint32_t events) {
-    uint32_t current_time = to_us_since_boot(get_absolute_time());
-    if (current_time - last_time > 200000) { //Apenas ativa as funções quando o intervalo entre acionamentos é superior a 0.2 segundos
-        last_time = current_time; //Atualiza o tempo do último evento
-        if (gpio == Bot_Left) {
-            if (ideal > 0) {
-                ideal -= 10; // Aumenta o valor de umidade ideal
-            } else {
-                ideal = 0; // Limita o valor de umidade ideal em 0%
-            }  
-        } else if (gpio == Bot_Right) {
-            if (ideal < 100) {
-                ideal += 10; // Diminui o valor de umidade ideal
-            } else {
-                ideal = 100; // Limita o valor de umidade ideal em 100%
-            }
-        } else if (gpio == Bot_Confirm) {
-            tempo_rega += 5; // Aumenta o tempo de rega
-            if (tempo_rega > 40) {
-                tempo_rega = 5; // Limita o tempo de rega em 40s
-            }
-            
-            //reset_usb_boot(0,0); //Habilita o modo de gravação do microcontrolador (Ativado em Período de Testes)
-        } else {
-        }   
-    }
+    botoes_borda(gpio, gpio_get(gpio));
 }
 
-
 // Função de inicialização de entradas, saídas e interrupções
 void init_pins(){
     // Entradas e habilitação de interrupções
     gpio_init(Bot_Left); // Inicializa o pino do botão esquerdo
     gpio_set_dir(Bot_Left, GPIO_IN); // Configura o pino do botão esquerdo como entrada
     gpio_pull_up(Bot_Left); // Habilita o pull-up do botão esquerdo
-    gpio_set_irq_enabled_with_callback(Bot_Left, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler); // Habilita a interrupção por borda de descida no botão esquerdo
+    gpio_set_irq_enabled_with_callback(Bot_Left, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &gpio_irq_handler); // Habilita a interrupção pelas duas bordas no botão esquerdo
     gpio_init(Bot_Right); // Inicializa o pino do botão direito
     gpio_set_dir(Bot_Right, GPIO_IN); // Configura o pino do botão direito como entrada
     gpio_pull_up(Bot_Right); // Habilita o pull-up do botão direito
-    gpio_set_irq_enabled_with_callback(Bot_Right, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler); // Habilita a interrupção por borda de descida no botão direito
+    gpio_set_irq_enabled_with_callback(Bot_Right, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &gpio_irq_handler); // Habilita a interrupção pelas duas bordas no botão direito
     gpio_init(Bot_Confirm); // Inicializa o pino do botão de confirmação
     gpio_set_dir(Bot_Confirm, GPIO_IN); // Configura o pino do botão de confirmação como entrada
     gpio_pull_up(Bot_Confirm); // Habilita o pull-up do botão de confirmação
-    gpio_set_irq_enabled_with_callback(Bot_Confirm, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler); // Habilita a interrupção por borda de descida no botão de confirmação
+    gpio_set_irq_enabled_with_callback(Bot_Confirm, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &gpio_irq_handler); // Habilita a interrupção pelas duas bordas no botão de confirmação
+    static const uint8_t botoes[] = {Bot_Left, Bot_Right, Bot_Confirm}; // Ordem de botao_t
+    botoes_init(botoes, count_of(botoes)); // Nível inicial de cada botão
+    agua_init(Sensor_Vazao, Sensor_Nivel); // Contador de pulsos no PIO e entrada da boia
     
     // Saídas
-    gpio_init(Relay); // Inicializa o pino do relé
-    gpio_set_dir(Relay, GPIO_OUT); // Configura o pino do relé como saída
-    
-    //Configurações da PIO e saída da Matriz de LEDs
-    pio = pio0;
-    uint offset = pio_add_program(pio, &matriz_program);
-    sm = pio_claim_unused_sm(pio, true);
-    matriz_program_init(pio, sm, offset, Matriz);
-}
-
-// Configura o PWM para uma frequência específica
-void pwm_setup(uint32_t freq) {
-    // Configura o pino para a função PWM
-    gpio_set_function(Buzzer, GPIO_FUNC_PWM);
-
-    // Obtém o slice de PWM associado ao pino
-    slice_num = pwm_gpio_to_slice_num(Buzzer);
-
-    // Obtém o clock do sistema
-    uint32_t clock = clock_get_hz(clk_sys);
-
-    // Calcula o divisor e wrap para obter a frequência desejada
-    uint32_t divider16 = (clock << 4) / freq;
-    uint32_t wrap = (divider16 + (1 << 4) - 1) >> 4;
-    
-    // Configura o PWM
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, 4.0f); // Ajusta o divisor de clock conforme necessário
-    pwm_init(slice_num, &config, true);
-
-    // Define o contador de wrap e o duty cycle para 50%
-    pwm_set_wrap(slice_num, wrap);
-    pwm_set_chan_level(slice_num, pwm_gpio_to_channel(Buzzer), wrap / 2);
-    pwm_set_enabled(slice_num, true); // Ativa o PWM antes do loop
-}
-
-// Função de callback para desligar o Relé após o tempo programado.
-int64_t turn_off_callback(alarm_id_t id, void *user_data) {
-    
-    if (!evento){
-        return 0;
-    } else {
-        // Desliga o Relé configurando o pino Relay para nível baixo.
-        gpio_put(Relay, false);
-        // Retorna 0 para indicar que o alarme não deve se repetir.
-        return 0;
-    }
+    matriz_leds_init(Matriz, Matriz_Fitas); // Programa PIO da matriz e canal de DMA (hal_leds_init)
+    buzzer_init(Buzzer); // PWM do buzzer configurado uma única vez; as notas só mudam wrap e nível
 }
 
-// Função para tocar o alerta alternando entre 250 Hz e 400 Hz
-void tocar_alerta() {
-    printf("Verificando alerta...\n");
-    sleep_ms(tempo_rega*1000-1000); // Aguarda 4 segundos antes de tocar o alerta, verifica se a umidade ainda está abaixo do ideal mesmo com a bomba ligada
-    evento = (gpio_get(Relay) && umidade*100 < (ideal - 20)); // Verifica se o evento de alerta precisa ser acionado
-    if (!evento) {
-        printf("Alerta cancelado...\n");
-        return;
-    } else {
-        printf("Tocando alerta...\n");
-        pwm_set_enabled(slice_num, true); // Ativa o PWM antes do loop
-        int tempo_nota = 250;  // Tempo de cada nota (ms)
-        int ciclos = Alerta_ms / (2 * tempo_nota);  // Número de alternâncias
-        add_alarm_in_ms(Alerta_ms, turn_off_callback, NULL, false); // Agenda o alarme para tocar o alerta novamente após 500ms
-        for (int i = 0; i < ciclos; i++) {
-            pwm_setup(250);
-            sleep_ms(tempo_nota);
-            pwm_setup(400);
-            sleep_ms(tempo_nota);
-        }
-        pwm_set_enabled(slice_num, false); // Desliga o PWM
-        printf("Alerta desligado...\n");
-    }
-}
-
-// Callback que verifica evento e toca o alerta após 1 segundo
-int64_t verificar_alerta_callback(alarm_id_t id, void *user_data) {
-    if (evento) {
-        tocar_alerta(); // Se o evento ainda for verdadeiro, toca o alerta
+// Laço do núcleo 1: display, LEDs e telemetria (jardim_interface), dormindo até o próximo retrato
+void core1_main() {
+    while (true) {
+        if (!jardim_interface())
+            hal_dormir(); // Acordado pelo hal_sinalizar de estado_publicar
     }
-    return 0; // Alarme não se repete
 }
 
 // Função de inicialização de protocolo de comunicação I2C e ADC
 void init_process(){
     // Inicialização da comunicação I2C. Utilizando a frequência de 400Khz.
-    i2c_init(I2C_PORT, 400*1000);
+    hal_i2c_init(I2C_PORT, 400*1000); // A taxa é reaplicada pela HAL quando o relógio do sistema muda
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);  // Configura o pino para I2C
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C); // Configura o pino para I2C
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, address, I2C_PORT); // Inicializa o display
-    ssd1306_config(&ssd); // Configura o display
-    ssd1306_send_data(&ssd); // Envia os dados para o display
-
-    // Limpa o display. O display inicia com todos os pixels apagados.
-    ssd1306_fill(&ssd, false);
-    ssd1306_send_data(&ssd);
-    
-    adc_gpio_init(Sensor_Luz); // Inicializa o pino do sensor LDR
-    adc_gpio_init(Sensor_Umidade); // Inicializa o pino do sensor de umidade
-    adc_init(); // Inicializa o ADC
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, address, I2C_PORT); // Só a memória: o display é configurado depois de composta a tela
+    ssd.column_scroll = Display_Rolagem; // Rolagem do gráfico pelo controlador, só se ele tiver o comando (ver ssd1306_scroll_left)
+
+    // Barramento do ADC I2C das zonas, separado do display (este fica com o núcleo 1 e a DMA)
+    hal_i2c_init(ZONAS_I2C, 400*1000);
+    gpio_set_function(I2C_ZONAS_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_ZONAS_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_ZONAS_SDA);
+    gpio_pull_up(I2C_ZONAS_SCL);
+
+    // Inicializa o ADC em modo contínuo: LDR (GPIO26), umidade (GPIO27), multiplexador (GPIO28) e
+    // temperatura interna em round-robin, via DMA
+    sensores_init();
+    sensores_set_oversampling(SENSOR_CANAL_LUZ, 4); // Média de 16 amostras
+    sensores_set_oversampling(SENSOR_CANAL_UMIDADE, 6); // Média de 64 amostras, a decisão do relé depende dela
+    sensores_set_oversampling(SENSOR_CANAL_MUX, 4); // 16 ms de média: cabe na acomodação após a troca de canal
 }    
 
 int main() {
@@ -225,64 +152,25 @@ int main() {
 
     init_pins();
     init_process();
-    
-    while (true) {
-        
-        ssd1306_fill(&ssd, 0); // Limpa o display
-        
-        evento = (gpio_get(Relay) && umidade*100 < (ideal - 20)); // Verifica se o evento de alerta precisa ser acionado
 
-        if (evento) {
-            tocar_alerta(); // Toca o alerta
-            evento = false; // Reseta o evento
-        } else {
-            // Acionamento da Iluminação de acordo com a luminosidade do ambiente
-            adc_select_input(0); // Seleciona o canal 0 do ADC, que corresponde ao pino 26, contendo o sensor de luminosidade
-            adc_value_luz = adc_read(); // Realiza a leitura do valor de luminosidade
-            intensidade = 1 - adc_value_luz/4095.0; // Ajusta a intensidade da matriz de LEDs de acordo com o valor de luminosidade
-            printf("Luminosidade: %d (%.0f%%)\n", adc_value_luz, (intensidade*100)); // Exibe o valor de luminosidade
-            sprintf(str_luz, "%.0f%%", (1-intensidade)*100);  // Converte o inteiro em string
-            ssd1306_draw_string(&ssd, "Luminosidade:", 3, 4); // Escreve a intensidade de luz no display
-            ssd1306_draw_string(&ssd, str_luz, 102, 4); // Escreve a porcenagem de luz no display
-            desenho(); // Atualiza a matriz de LEDs de acordo com a intensidade de luz
-    
-            
-            // Definições de parâmentros de rega
-            ssd1306_draw_string(&ssd, "Umidade Ideal:", 3, 28); // Escreve o nível de umidade ideal para a planta no display
-            sprintf(str_ideal, "%d%%", ideal);  // Converte o inteiro em string
-            ssd1306_draw_string(&ssd, str_ideal, 102, 28); // Escreve a porcenagem de umidade ideal no display
-            ssd1306_draw_string(&ssd, "Tempo de Rega:", 3, 40); // Escreve o tamanho do vaso no display
-            sprintf(str_rega, "%ds", tempo_rega);  // Converte o inteiro em string
-            ssd1306_draw_string(&ssd, str_rega, 102, 40); // Escreve o tempo de rega no display
-            
-            // Acionamento do Relé de acordo com a umidade do solo
-            adc_select_input(1); // Seleciona o canal 1 do ADC, que corresponde ao pino 27, contendo o sensor de umidade do solo
-            adc_value_umidade = adc_read(); // Realiza a leitura do valor de umidade do solo
-            umidade = adc_value_umidade/4095.0; // Ajusta a intensidade da matriz de LEDs de acordo com o valor de luminosidade
-            printf("Umidade do solo: %d (%.0f%%)\n", adc_value_umidade, (umidade*100)); // Exibe o valor de umidade do solo
-            sprintf(str_umid, "%.0f%%", umidade*100);  // Converte o valor percentual em string
-            ssd1306_draw_string(&ssd, "Umidade do solo:", 3, 16); // Escreve a umidade do solo no display
-            ssd1306_draw_string(&ssd, str_umid, 102, 16); // Escreve a porcenagem de umidade no display
-            if (umidade*100 < (ideal - 20)) {
-                gpio_put(Relay, 1); // Liga o relé
-                ssd1306_draw_string(&ssd, "Irrigando...", 3, 52); // Escreve a mensagem de "irrigação" no display
-                // Agendar o desligamento do relé após o tempo de rega
-                add_alarm_in_ms((tempo_rega * 1000), turn_off_callback, NULL, false);
+    // Tarefas de controle do núcleo 0, relés e varredura inicial das zonas
+    jardim_init(&ssd, zonas, count_of(zonas));
+    if (Rede_Ligada)
+        hal_uart_init(REDE_BAUD, Rede_TX, Rede_RX, Rede_DE);
+    if (Rede_Endereco)
+        jardim_rede(Rede_Endereco); // As regas passam a esperar a vez dada pelo coordenador
+    if (Rede_Nos)
+        jardim_coordenar(Rede_Nos, Rede_Bombas); // Consultas e vez da bomba pelo núcleo 0; ajustes pela serial
 
-                // Agendar a verificação do alerta 1 segundo depois
-                //add_alarm_in_ms(1000, verificar_alerta_callback, NULL, false);
-            } else if (umidade*100 > (ideal - 20) && umidade*100 < (ideal + 20)) {
-                ssd1306_draw_string(&ssd, "Rega em breve!", 3, 52); // Escreve a mensagem de "rega em breve" no display
-            } else if (umidade*100 > (ideal + 20)) {
-                ssd1306_draw_string(&ssd, "Solo umido!", 3, 52); // Escreve a mensagem de "solo umido" no display
-            }
-            
-        }
-        
-        ssd1306_rect(&ssd, 1, 1, 126, 62, 1, 0); // Borda do display
-        ssd1306_send_data(&ssd); // Atualiza o display
+    // Display configurado em uma única transação I2C e ainda desligado; o primeiro quadro, já com a
+    // tela do jardim (e não um quadro em branco), sai pelo núcleo 1, que então liga o display
+    ssd1306_config(&ssd);
 
-        sleep_ms(100); // Aguarda 100ms para não sobrecarregar a CPU
+    // Núcleo 1: display, LEDs e telemetria. Os periféricos já foram inicializados acima.
+    multicore_launch_core1(core1_main);
+    hal_flash_pausavel(); // O núcleo 1 grava o histórico; este núcleo espera na RAM durante a gravação
 
+    while (true) {
+        jardim_controle(); // Executa as tarefas vencidas ou dorme até o próximo prazo (ou até um botão)
     }
 }
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include "agenda.h"
+
+static tarefa_t tarefas[AGENDA_MAX_TAREFAS];
+static uint8_t total;
+static int8_t primeira = -1; // Tarefa com o prazo mais próximo
+static uint64_t dormindo_us; // Tempo total dentro de hal_dormir / hal_dormir_ate
+
+static void zerar(tarefa_t *t) {
+  t->execucoes = 0;
+  t->latencia_min_us = UINT32_MAX;
+  t->latencia_max_us = 0;
+  t->latencia_soma_us = 0;
+  t->duracao_max_us = 0;
+}
+
+// Retira a tarefa da fila, se estiver nela
+static void remover(int id) {
+  if (!tarefas[id].agendada)
+    return;
+  int8_t *elo = &primeira;
+  while (*elo != id)
+    elo = &tarefas[*elo].proxima;
+  *elo = tarefas[id].proxima;
+  tarefas[id].agendada = false;
+}
+
+// Insere mantendo a ordem por prazo; prazos iguais preservam a ordem de inserção
+static void inserir(int id, uint64_t prazo_us) {
+  remover(id);
+  tarefas[id].prazo_us = prazo_us;
+  int8_t *elo = &primeira;
+  while (*elo >= 0 && tarefas[*elo].prazo_us <= prazo_us)
+    elo = &tarefas[*elo].proxima;
+  tarefas[id].proxima = *elo;
+  *elo = id;
+  tarefas[id].agendada = true;
+}
+
+// Registra uma tarefa (ainda não agendada). Retorna o identificador ou -1 se não houver espaço.
+int agenda_tarefa(const char *nome, tarefa_fn_t fn, void *ctx) {
+  if (total >= AGENDA_MAX_TAREFAS)
+    return -1;
+  tarefa_t *t = &tarefas[total];
+  t->nome = nome;
+  t->fn = fn;
+  t->ctx = ctx;
+  t->proxima = -1;
+  zerar(t);
+  return total++;
+}
+
+// Executa a tarefa a cada periodo_ms, a partir de agora
+void agenda_periodo(int id, uint32_t periodo_ms) {
+  tarefas[id].periodo_us = periodo_ms * 1000u;
+  inserir(id, hal_tempo_us());
+}
+
+// Executa a tarefa uma única vez daqui a atraso_ms (reagendar substitui o prazo anterior)
+void agenda_em(int id, uint32_t atraso_ms) {
+  tarefas[id].periodo_us = 0;
+  inserir(id, hal_tempo_us() + atraso_ms * 1000ull);
+}
+
+void agenda_cancelar(int id) {
+  remover(id);
+}
+
+bool agenda_pendente(int id) {
+  return tarefas[id].agendada;
+}
+
+// Executa as tarefas vencidas, em ordem de prazo. Sem nada vencido, dorme até o próximo prazo
+// ou até qualquer interrupção.
+void agenda_executar(void) {
+  uint64_t antes = hal_tempo_us();
+  if (primeira < 0) {
+    hal_dormir();
+    dormindo_us += hal_tempo_us() - antes;
+    return;
+  }
+
+  int id = primeira;
+  tarefa_t *t = &tarefas[id];
+  uint64_t agora = antes;
+  if (agora < t->prazo_us) {
+    hal_dormir_ate(t->prazo_us);
+    dormindo_us += hal_tempo_us() - antes;
+    return;
+  }
+
+  uint32_t latencia = agora - t->prazo_us;
+  uint64_t prazo = t->prazo_us;
+  remover(id);
+  if (t->periodo_us) {
+    // Periódica: mantém a fase; se atrasou mais de um período, pula as execuções perdidas
+    prazo += t->periodo_us;
+    if (prazo <= agora)
+      prazo = agora + t->periodo_us - (agora - prazo) % t->periodo_us;
+    inserir(id, prazo);
+  }
+
+  t->fn(t->ctx);
+
+  uint32_t duracao = hal_tempo_us() - agora;
+  ++t->execucoes;
+  t->latencia_soma_us += latencia;
+  if (latencia < t->latencia_min_us)
+    t->latencia_min_us = latencia;
+  if (latencia > t->latencia_max_us)
+    t->latencia_max_us = latencia;
+  if (duracao > t->duracao_max_us)
+    t->duracao_max_us = duracao;
+}
+
+uint64_t agenda_tempo_dormindo_us(void) {
+  return dormindo_us;
+}
+
+const tarefa_t *agenda_estatisticas(int id) {
+  return &tarefas[id];
+}
+
+// Pior latência, jitter (máx - mín da latência) e pior duração de cada tarefa, em microssegundos
+void agenda_relatorio(void) {
+  printf("%-12s %8s %8s %8s %8s %8s\n", "tarefa", "execs", "lat_med", "lat_max", "jitter", "dur_max");
+  for (uint8_t i = 0; i < total; ++i) {
+    const tarefa_t *t = &tarefas[i];
+    if (!t->execucoes)
+      continue;
+    printf("%-12s %8lu %8lu %8lu %8lu %8lu\n", t->nome, (unsigned long)t->execucoes,
+           (unsigned long)(t->latencia_soma_us / t->execucoes), (unsigned long)t->latencia_max_us,
+           (unsigned long)(t->latencia_max_us - t->latencia_min_us), (unsigned long)t->duracao_max_us);
+  }
+}
+
+void agenda_zerar_estatisticas(void) {
+  for (uint8_t i = 0; i < total; ++i)
+    zerar(&tarefas[i]);
+}
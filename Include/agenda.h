@@ -0,0 +1,39 @@
+#ifndef AGENDA_H
+#define AGENDA_H
+
+#include "hal.h"
+
+// Escalonador cooperativo ordenado por prazo. Cada tarefa é uma função curta que nunca bloqueia;
+// esperas viram continuações agendadas (agenda_em) e atividades recorrentes usam agenda_periodo.
+
+#define AGENDA_MAX_TAREFAS 16
+
+typedef void (*tarefa_fn_t)(void *ctx);
+
+typedef struct {
+  const char *nome;
+  tarefa_fn_t fn;
+  void *ctx;
+  uint64_t prazo_us; // Próxima execução (tempo absoluto desde o boot)
+  uint32_t periodo_us; // 0 = tarefa única
+  int8_t proxima; // Encadeamento da fila ordenada por prazo (-1 = fim)
+  bool agendada;
+  // Estatísticas: latência = início da execução - prazo
+  uint32_t execucoes;
+  uint32_t latencia_min_us, latencia_max_us;
+  uint64_t latencia_soma_us;
+  uint32_t duracao_max_us;
+} tarefa_t;
+
+int agenda_tarefa(const char *nome, tarefa_fn_t fn, void *ctx);
+void agenda_periodo(int id, uint32_t periodo_ms);
+void agenda_em(int id, uint32_t atraso_ms);
+void agenda_cancelar(int id);
+bool agenda_pendente(int id);
+void agenda_executar(void);
+uint64_t agenda_tempo_dormindo_us(void); // Residência em sono do núcleo que roda a agenda
+const tarefa_t *agenda_estatisticas(int id);
+void agenda_relatorio(void);
+void agenda_zerar_estatisticas(void);
+
+#endif
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include "agua.h"
+
+static int8_t pino_fluxo = -1, pino_nivel = -1;
+static int8_t zona = -1; // Rega sendo medida
+static uint32_t pulsos_inicio, pulsos_conferidos;
+static uint64_t seco_us; // Última vez que a bomba rodou a seco (0 = nunca)
+static bool baixo; // Última leitura da boia
+static uint32_t ml_ultima[ZONAS_MAX], ml_total[ZONAS_MAX];
+static uint32_t secas;
+
+void agua_init(int8_t fluxo, int8_t nivel) {
+  pino_fluxo = fluxo;
+  pino_nivel = nivel;
+  if (pino_fluxo >= 0)
+    hal_fluxo_init(pino_fluxo);
+  if (pino_nivel >= 0)
+    hal_gpio_entrada(pino_nivel);
+}
+
+// A boia fecha o contato com a água acima do nível mínimo: pino em alto (pull-up) é reservatório
+// baixo, e também um sensor desconectado, o que mantém a bomba parada
+bool agua_reservatorio_baixo(void) {
+  bool agora_baixo = pino_nivel >= 0 && hal_gpio_get(pino_nivel);
+  if (baixo && !agora_baixo)
+    seco_us = 0; // Reservatório reabastecido: libera as regas sem esperar o bloqueio
+  baixo = agora_baixo;
+  return baixo;
+}
+
+static bool bloqueio_seco(void) {
+  return seco_us && hal_tempo_us() - seco_us < AGUA_BLOQUEIO_MS * 1000ull;
+}
+
+bool agua_bloqueada(void) {
+  return agua_reservatorio_baixo() || bloqueio_seco();
+}
+
+static uint32_t pulsos(void) {
+  return pino_fluxo >= 0 ? hal_fluxo_pulsos() : 0;
+}
+
+void agua_inicio(uint8_t z) {
+  zona = z;
+  pulsos_inicio = pulsos_conferidos = pulsos();
+}
+
+bool agua_conferir(void) {
+  if (zona < 0 || pino_fluxo < 0)
+    return true; // Sem sensor de vazão não há como saber
+  uint32_t p = pulsos();
+  bool ok = p - pulsos_conferidos >= AGUA_PULSOS_MIN;
+  pulsos_conferidos = p;
+  if (!ok) {
+    seco_us = hal_tempo_us();
+    ++secas;
+  }
+  return ok;
+}
+
+void agua_fim(void) {
+  if (zona < 0)
+    return;
+  uint32_t ml = (uint64_t)(pulsos() - pulsos_inicio) * 1000 / AGUA_PULSOS_POR_LITRO;
+  ml_ultima[zona] = ml;
+  ml_total[zona] += ml;
+  zona = -1;
+}
+
+int8_t agua_zona(void) {
+  return zona;
+}
+
+uint32_t agua_ml_ultima(uint8_t z) {
+  return ml_ultima[z];
+}
+
+uint32_t agua_ml_total(uint8_t z) {
+  return ml_total[z];
+}
+
+uint32_t agua_secas(void) {
+  return secas;
+}
+
+// Só lê o estado: chamada pelo relatório do núcleo 1
+void agua_relatorio(void) {
+  printf("Água: reservatório %s, %lu regas cortadas a seco%s\n", baixo ? "baixo" : "ok", (unsigned long)secas,
+         baixo || bloqueio_seco() ? " (regas bloqueadas)" : "");
+  for (uint8_t z = 0; z < ZONAS_MAX; ++z)
+    if (ml_total[z])
+      printf("  zona %u: última rega %lu mL, total %lu.%03lu L\n", z + 1, (unsigned long)ml_ultima[z],
+             (unsigned long)(ml_total[z] / 1000), (unsigned long)(ml_total[z] % 1000));
+}
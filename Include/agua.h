@@ -0,0 +1,33 @@
+#ifndef AGUA_H
+#define AGUA_H
+
+#include "hal.h"
+#include "zonas.h"
+
+// Contabilidade da água: sensor de vazão na saída da bomba (pulsos contados pelo PIO, ver
+// hal_fluxo_pulsos) e boia de nível mínimo no reservatório. Com a bomba ligada a vazão é conferida
+// AGUA_PARTIDA_MS depois da partida e então a cada AGUA_JANELA_MS: sem pulsos a bomba roda a seco
+// e a rega deve ser cortada na hora. Ao fim de cada rega fica registrada a água entregue à zona.
+//
+// Antes só havia o alerta indireto: com o relé ligado quase o tempo de rega inteiro, a umidade
+// ainda abaixo de (ideal - 20)% indicava falta de água.
+
+#define AGUA_PULSOS_POR_LITRO 450 // YF-S201: f = 7,5 Hz por L/min
+#define AGUA_PARTIDA_MS 400 // Primeira conferência: tempo para a água chegar ao sensor
+#define AGUA_JANELA_MS 300
+#define AGUA_PULSOS_MIN 2 // Por janela (~15 mL/s): abaixo disso a bomba está a seco
+#define AGUA_BLOQUEIO_MS 600000 // Depois de rodar a seco, nenhuma rega por este tempo ou até a boia voltar
+
+void agua_init(int8_t pino_fluxo, int8_t pino_nivel); // -1 = sensor ausente
+bool agua_reservatorio_baixo(void); // Boia abaixo do nível mínimo
+bool agua_bloqueada(void); // Reservatório baixo ou bomba a seco há pouco: nenhuma rega deve começar
+void agua_inicio(uint8_t zona); // O relé da zona acabou de ligar
+bool agua_conferir(void); // Vazão desde a última conferência; false = a seco (bloqueia as regas)
+void agua_fim(void); // O relé desligou: contabiliza a água entregue à zona
+int8_t agua_zona(void); // Zona com a rega sendo medida (-1 = nenhuma)
+uint32_t agua_ml_ultima(uint8_t zona); // Água entregue na última rega da zona
+uint32_t agua_ml_total(uint8_t zona);
+uint32_t agua_secas(void); // Regas cortadas por falta de vazão
+void agua_relatorio(void);
+
+#endif
@@ -0,0 +1,127 @@
+#include <stddef.h>
+#include <string.h>
+#include "ajustes.h"
+#include "quadro.h"
+
+#define REGISTROS_POR_SETOR (HAL_FLASH_SETOR / sizeof(ajustes_registro_t))
+#define REGISTROS_POR_PAGINA (HAL_FLASH_PAGINA / sizeof(ajustes_registro_t))
+
+static uint32_t sequencia; // Do registro mais recente na flash (0 = nenhum)
+static uint8_t setor; // Setor do par em uso
+static uint16_t livre; // Próxima posição livre no setor em uso (REGISTROS_POR_SETOR = cheio)
+static bool outro_apagado; // O outro setor já foi apagado para receber a próxima gravação
+static int8_t salvo_ideal[ZONAS_MAX], salvo_rega[ZONAS_MAX]; // Valores do registro mais recente
+static int8_t visto_ideal[ZONAS_MAX], visto_rega[ZONAS_MAX]; // Últimos valores recebidos
+static uint64_t mudou_us;
+static bool carregados;
+static uint32_t gravacoes;
+
+static const ajustes_registro_t *registro(uint8_t s, uint16_t i) {
+  return (const ajustes_registro_t *)hal_flash_ler(AJUSTES_INICIO + s * HAL_FLASH_SETOR + i * sizeof(ajustes_registro_t));
+}
+
+static bool valido(const ajustes_registro_t *r) {
+  return r->magico == AJUSTES_MAGICO && r->versao == AJUSTES_VERSAO && r->zonas <= ZONAS_MAX &&
+         r->crc == quadro_crc16((const uint8_t *)r, offsetof(ajustes_registro_t, crc));
+}
+
+// Primeira posição depois da última usada (válida ou não: uma gravação interrompida também ocupa)
+static uint16_t primeira_livre(uint8_t s) {
+  uint16_t i = REGISTROS_POR_SETOR;
+  while (i > 0 && registro(s, i - 1)->magico == 0xFFFFFFFFu)
+    --i;
+  return i;
+}
+
+bool ajustes_carregar(volatile int8_t *ideal, volatile int8_t *tempo_rega, uint8_t zonas) {
+  const ajustes_registro_t *mais_novo = NULL;
+  for (uint8_t s = 0; s < AJUSTES_SETORES; ++s) {
+    for (uint16_t i = 0; i < REGISTROS_POR_SETOR; ++i) {
+      const ajustes_registro_t *r = registro(s, i);
+      if (valido(r) && (!mais_novo || r->sequencia > mais_novo->sequencia)) {
+        mais_novo = r;
+        setor = s;
+      }
+    }
+  }
+  carregados = mais_novo != NULL;
+  if (carregados) {
+    sequencia = mais_novo->sequencia;
+    // Só valores dentro dos limites dos botões; zonas a mais na tabela ficam com o valor dela
+    for (uint8_t z = 0; z < zonas && z < mais_novo->zonas; ++z) {
+      if (mais_novo->ideal[z] >= 0 && mais_novo->ideal[z] <= 100)
+        ideal[z] = mais_novo->ideal[z];
+      if (mais_novo->tempo_rega[z] >= 5 && mais_novo->tempo_rega[z] <= 40)
+        tempo_rega[z] = mais_novo->tempo_rega[z];
+    }
+  }
+  livre = primeira_livre(setor);
+  outro_apagado = false;
+  for (uint8_t z = 0; z < ZONAS_MAX; ++z) {
+    salvo_ideal[z] = visto_ideal[z] = z < zonas ? ideal[z] : 0;
+    salvo_rega[z] = visto_rega[z] = z < zonas ? tempo_rega[z] : 0;
+  }
+  return carregados;
+}
+
+static void gravar(uint8_t zonas) {
+  ajustes_registro_t r;
+  memset(&r, 0xFF, sizeof r);
+  r.magico = AJUSTES_MAGICO;
+  r.sequencia = sequencia + 1;
+  r.versao = AJUSTES_VERSAO;
+  r.zonas = zonas;
+  memcpy(r.ideal, visto_ideal, sizeof r.ideal);
+  memcpy(r.tempo_rega, visto_rega, sizeof r.tempo_rega);
+  r.crc = quadro_crc16((const uint8_t *)&r, offsetof(ajustes_registro_t, crc));
+
+  // Página em 0xFF com o registro na sua posição: os bytes já gravados da página não mudam
+  static uint8_t pagina[HAL_FLASH_PAGINA];
+  memset(pagina, 0xFF, sizeof pagina);
+  memcpy(&pagina[(livre % REGISTROS_POR_PAGINA) * sizeof r], &r, sizeof r);
+  uint32_t deslocamento = AJUSTES_INICIO + setor * HAL_FLASH_SETOR + (livre / REGISTROS_POR_PAGINA) * HAL_FLASH_PAGINA;
+  hal_flash_programar(deslocamento, pagina);
+
+  sequencia = r.sequencia;
+  livre++;
+  memcpy(salvo_ideal, visto_ideal, sizeof salvo_ideal);
+  memcpy(salvo_rega, visto_rega, sizeof salvo_rega);
+  gravacoes++;
+}
+
+bool ajustes_executar(const int8_t *ideal, const int8_t *tempo_rega, uint8_t zonas) {
+  uint64_t agora = hal_tempo_us();
+  if (memcmp(visto_ideal, ideal, zonas) || memcmp(visto_rega, tempo_rega, zonas)) {
+    memcpy(visto_ideal, ideal, zonas);
+    memcpy(visto_rega, tempo_rega, zonas);
+    mudou_us = agora; // Reinicia a espera a cada toque
+    return false;
+  }
+  if (!memcmp(salvo_ideal, visto_ideal, zonas) && !memcmp(salvo_rega, visto_rega, zonas))
+    return false;
+  if (agora - mudou_us < AJUSTES_ATRASO_MS * 1000ull)
+    return false;
+
+  if (livre >= REGISTROS_POR_SETOR) {
+    // Setor cheio: a próxima gravação vai para o outro, apagado antes (o cheio mantém a cópia atual)
+    uint8_t outro = (setor + 1) % AJUSTES_SETORES;
+    if (!outro_apagado) {
+      hal_flash_apagar(AJUSTES_INICIO + outro * HAL_FLASH_SETOR);
+      outro_apagado = true;
+      return true;
+    }
+    setor = outro;
+    livre = 0;
+    outro_apagado = false;
+  }
+  gravar(zonas);
+  return true;
+}
+
+bool ajustes_carregados(void) {
+  return carregados;
+}
+
+uint32_t ajustes_gravacoes(void) {
+  return gravacoes;
+}
@@ -0,0 +1,43 @@
+#ifndef AJUSTES_H
+#define AJUSTES_H
+
+#include "hal.h"
+#include "zonas.h"
+#include "registro.h" // AJUSTES_INICIO fica logo abaixo do histórico
+
+// Ajustes dos botões (umidade ideal e tempo de rega de cada zona) guardados na flash, para que um
+// reinício não volte aos valores da tabela de zonas. Cada gravação é um registro novo de 32 bytes
+// com versão, número de sequência e CRC-16 (quadro_crc16), acrescentado no próximo espaço livre de
+// um par de setores logo abaixo do histórico: o setor só é apagado quando enche, e sempre o outro,
+// de modo que o registro mais recente nunca fica sem cópia válida. No boot vale o registro válido
+// de maior sequência; com a versão diferente ou o CRC errado ficam os valores da tabela.
+//
+// A gravação é preguiçosa: só depois de AJUSTES_ATRASO_MS sem novas mudanças, para que uma sequência
+// de toques nos botões vire uma única gravação, e sempre no núcleo 1 (como o histórico).
+
+#define AJUSTES_SETORES 2
+#define AJUSTES_INICIO (REGISTRO_INICIO - AJUSTES_SETORES * HAL_FLASH_SETOR)
+#define AJUSTES_MAGICO 0x47464347u // "GCFG"
+#define AJUSTES_VERSAO 1
+#define AJUSTES_ATRASO_MS 10000
+
+typedef struct {
+  uint32_t magico;
+  uint32_t sequencia;
+  uint8_t versao;
+  uint8_t zonas;
+  int8_t ideal[ZONAS_MAX];
+  int8_t tempo_rega[ZONAS_MAX];
+  uint8_t reservado[4]; // 0xFF
+  uint16_t crc; // Dos bytes anteriores
+} ajustes_registro_t; // 32 bytes: 8 por página, 128 por setor
+
+// Aplica o registro mais recente sobre os valores da tabela; false se não havia registro válido
+bool ajustes_carregar(volatile int8_t *ideal, volatile int8_t *tempo_rega, uint8_t zonas);
+// Acompanha os valores em uso e grava quando ficam estáveis; no máximo uma operação de flash por
+// chamada (true se houve)
+bool ajustes_executar(const int8_t *ideal, const int8_t *tempo_rega, uint8_t zonas);
+bool ajustes_carregados(void);
+uint32_t ajustes_gravacoes(void);
+
+#endif
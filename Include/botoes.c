@@ -0,0 +1,157 @@
+#include "botoes.h"
+
+#define ESTAVEL_US (BOTOES_ESTAVEL_MS * 1000ull)
+#define LONGO_US (BOTOES_LONGO_MS * 1000ull)
+#define REPETICAO_US (BOTOES_REPETICAO_MS * 1000ull)
+
+typedef struct {
+  uint32_t t_us; // 32 bits bastam: o consumidor reconstrói o instante completo a partir do atual
+  uint8_t botao;
+  bool nivel;
+} borda_t;
+
+typedef struct {
+  uint8_t pino;
+  bool bruto; // Pressionado segundo a última borda
+  bool estavel; // Pressionado segundo o nível que vale
+  bool longo; // Toque longo já emitido neste toque
+  uint64_t bruto_us; // Instante da última borda
+  uint64_t prazo_us; // Próximo toque longo ou repetição, enquanto pressionado
+} botao_estado_t;
+
+static botao_estado_t botoes[BOTOES_MAX];
+static uint8_t total;
+
+// Fila de bordas: escrita só pela interrupção, lida só pelo núcleo 0 (mesmo esquema de estado.c)
+static borda_t fila[BOTOES_FILA];
+static volatile uint32_t cabeca; // Escrito apenas pela interrupção
+static volatile uint32_t cauda; // Escrito apenas pelo núcleo 0
+static volatile bool ressincronizar; // Borda perdida: o consumidor relê os pinos
+static volatile uint32_t bordas, descartadas;
+
+// Eventos prontos, só no núcleo 0
+static botao_evento_t eventos[BOTOES_EVENTOS];
+static uint32_t eventos_cabeca, eventos_cauda, total_eventos;
+
+void botoes_init(const uint8_t *pinos, uint8_t n) {
+  total = n > BOTOES_MAX ? BOTOES_MAX : n;
+  uint64_t agora = hal_tempo_us();
+  for (uint8_t i = 0; i < total; ++i) {
+    bool pressionado = !hal_gpio_get(pinos[i]);
+    botoes[i] = (botao_estado_t){
+        .pino = pinos[i],
+        .bruto = pressionado,
+        .estavel = pressionado,
+        .longo = true, // Segurado desde o boot: nem clique nem toque longo
+        .bruto_us = agora,
+        .prazo_us = UINT64_MAX,
+    };
+  }
+}
+
+void botoes_borda(uint pino, bool nivel) {
+  uint8_t i = 0;
+  while (i < total && botoes[i].pino != pino)
+    ++i;
+  if (i == total)
+    return;
+  bordas = bordas + 1;
+  uint32_t c = cabeca;
+  if (c - cauda >= BOTOES_FILA) {
+    descartadas = descartadas + 1;
+    ressincronizar = true;
+    return;
+  }
+  fila[c & (BOTOES_FILA - 1)] = (borda_t){(uint32_t)hal_tempo_us(), i, nivel};
+  hal_barreira(); // O conteúdo precisa estar visível antes do novo índice
+  cabeca = c + 1;
+}
+
+bool botoes_pendentes(void) {
+  return cabeca != cauda || ressincronizar;
+}
+
+static void emitir(uint8_t botao, botao_acao_t acao, uint64_t t_us) {
+  ++total_eventos;
+  if (eventos_cabeca - eventos_cauda >= BOTOES_EVENTOS)
+    return; // Ninguém leu os anteriores: o evento se perde
+  eventos[eventos_cabeca++ & (BOTOES_EVENTOS - 1)] = (botao_evento_t){botao, acao, t_us};
+}
+
+// Avança a máquina de estados do botão até o instante t, antes de aplicar uma borda nova ou no fim
+// do processamento. Os eventos levam o instante em que aconteceram, não o do processamento.
+static void avaliar(uint8_t i, uint64_t t) {
+  botao_estado_t *b = &botoes[i];
+  if (b->bruto != b->estavel && t - b->bruto_us >= ESTAVEL_US) {
+    uint64_t quando = b->bruto_us + ESTAVEL_US;
+    b->estavel = b->bruto;
+    if (b->estavel) {
+      b->longo = false;
+      b->prazo_us = quando + LONGO_US;
+      emitir(i, BOTAO_PRESSIONADO, quando);
+    } else if (!b->longo) {
+      emitir(i, BOTAO_CLIQUE, quando);
+    }
+  }
+  if (b->estavel && t >= b->prazo_us) {
+    emitir(i, b->longo ? BOTAO_REPETICAO : BOTAO_LONGO, b->prazo_us);
+    b->longo = true;
+    b->prazo_us += REPETICAO_US;
+    if (b->prazo_us <= t)
+      b->prazo_us = t + REPETICAO_US; // Processamento atrasado: pula as repetições perdidas
+  }
+}
+
+int32_t botoes_processar(void) {
+  // Índice antes do relógio: toda borda na fila foi marcada antes de agora
+  uint32_t c = cabeca;
+  hal_barreira();
+  uint64_t agora = hal_tempo_us();
+  for (uint32_t k = cauda; k != c; ++k) {
+    borda_t borda = fila[k & (BOTOES_FILA - 1)];
+    uint64_t t = agora - (uint32_t)((uint32_t)agora - borda.t_us);
+    avaliar(borda.botao, t);
+    botoes[borda.botao].bruto = !borda.nivel;
+    botoes[borda.botao].bruto_us = t;
+  }
+  hal_barreira(); // Leitura concluída antes de liberar as posições para a interrupção
+  cauda = c;
+  if (ressincronizar) {
+    ressincronizar = false;
+    for (uint8_t i = 0; i < total; ++i) {
+      botoes[i].bruto = !hal_gpio_get(botoes[i].pino);
+      botoes[i].bruto_us = agora;
+    }
+  }
+
+  uint64_t proximo = UINT64_MAX;
+  for (uint8_t i = 0; i < total; ++i) {
+    avaliar(i, agora);
+    botao_estado_t *b = &botoes[i];
+    uint64_t prazo = b->bruto != b->estavel ? b->bruto_us + ESTAVEL_US : b->estavel ? b->prazo_us : UINT64_MAX;
+    if (prazo < proximo)
+      proximo = prazo;
+  }
+  if (proximo == UINT64_MAX)
+    return -1;
+  return (proximo - agora + 999) / 1000;
+}
+
+bool botoes_evento(botao_evento_t *e) {
+  if (eventos_cauda == eventos_cabeca)
+    return false;
+  *e = eventos[eventos_cauda++ & (BOTOES_EVENTOS - 1)];
+  return true;
+}
+
+uint32_t botoes_bordas(void) {
+  return bordas;
+}
+
+uint32_t botoes_eventos(void) {
+  return total_eventos;
+}
+
+uint32_t botoes_descartadas(void) {
+  return descartadas;
+}
@@ -0,0 +1,51 @@
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include "hal.h"
+
+// Entrada dos botões. A interrupção do GPIO só registra a borda (instante, botão e nível do pino)
+// em uma fila SPSC sem travas; nada do controle é alterado dentro dela. O núcleo 0 esvazia a fila
+// em botoes_processar e passa cada botão por uma máquina de estados própria: um nível só vale
+// depois de BOTOES_ESTAVEL_MS sem novas bordas (o ruído de contato de um botão não atrasa os
+// outros), e um botão segurado gera o toque longo e, em seguida, repetições para percorrer os
+// valores rapidamente. O resultado são eventos lidos com botoes_evento.
+//
+// Os botões ligam o pino ao GND (pull-up interno): nível baixo = pressionado.
+
+#define BOTOES_MAX 4
+#define BOTOES_FILA 32 // Bordas pendentes, potência de 2: com ruído de contato, ~5 toques
+#define BOTOES_EVENTOS 16 // Eventos ainda não lidos, potência de 2
+#define BOTOES_ESTAVEL_MS 20 // Sem bordas por este tempo: o nível do pino vale
+#define BOTOES_LONGO_MS 800 // Segurado por este tempo: toque longo
+#define BOTOES_REPETICAO_MS 150 // Depois do toque longo, uma repetição a cada intervalo
+
+// Índices dos botões da placa: a ordem dos pinos passados a botoes_init
+typedef enum {
+  BOTAO_ESQUERDO,
+  BOTAO_DIREITO,
+  BOTAO_CONFIRMA
+} botao_t;
+
+typedef enum {
+  BOTAO_PRESSIONADO, // Assim que o nível baixo fica estável
+  BOTAO_CLIQUE, // Solto antes do toque longo
+  BOTAO_LONGO, // Segurado por BOTOES_LONGO_MS
+  BOTAO_REPETICAO // Ainda segurado, a cada BOTOES_REPETICAO_MS depois do toque longo
+} botao_acao_t;
+
+typedef struct {
+  uint8_t botao;
+  botao_acao_t acao;
+  uint64_t t_us; // Instante em que o evento aconteceu (a borda mais o tempo de estabilização)
+} botao_evento_t;
+
+void botoes_init(const uint8_t *pinos, uint8_t total); // Lê o nível atual dos pinos já configurados
+void botoes_borda(uint pino, bool nivel); // Interrupção do GPIO: só enfileira a borda
+bool botoes_pendentes(void); // Há bordas na fila
+int32_t botoes_processar(void); // Núcleo 0: ms até o próximo prazo das máquinas de estados, -1 se nenhum
+bool botoes_evento(botao_evento_t *e); // Próximo evento gerado por botoes_processar
+uint32_t botoes_bordas(void);
+uint32_t botoes_eventos(void);
+uint32_t botoes_descartadas(void); // Bordas perdidas com a fila cheia (os níveis são relidos dos pinos)
+
+#endif
@@ -0,0 +1,59 @@
+#include <string.h>
+#include "buzzer.h"
+
+static uint buzzer_pin;
+
+static nota_t notas_ram[BUZZER_NOTAS_MAX]; // Cópia da melodia: o alarme também toca durante as gravações da flash
+static const nota_t *volatile melodia;
+static volatile uint8_t total_notas, repeticoes_restantes, nota_atual;
+static volatile hal_alarme_t alarme;
+
+void buzzer_init(uint pin) {
+  buzzer_pin = pin;
+  hal_pwm_init(pin); // Função do pino e divisor fixo, configurados uma única vez
+}
+
+// Contexto de interrupção: avança um passo e devolve a duração do próximo, medida a partir do
+// instante agendado deste alarme (retorno positivo), o que mantém o ritmo sem acumular atraso.
+// Na RAM, com a melodia copiada para a RAM: ver hal_flash_apagar.
+static int64_t __not_in_flash_func(proximo_passo)(hal_alarme_t id, void *user_data) {
+  if (++nota_atual >= total_notas) {
+    nota_atual = 0;
+    if (!repeticoes_restantes || !--repeticoes_restantes) {
+      hal_pwm_tom(buzzer_pin, 0);
+      melodia = NULL;
+      alarme = 0;
+      return 0;
+    }
+  }
+  hal_pwm_tom(buzzer_pin, melodia[nota_atual].freq_hz);
+  return melodia[nota_atual].dur_ms * 1000ll;
+}
+
+// Toca a tabela de notas 'repeticoes' vezes (0 = até buzzer_parar). Retorna imediatamente.
+void buzzer_tocar(const nota_t *notas, uint8_t total, uint8_t repeticoes) {
+  buzzer_parar();
+  if (!total)
+    return;
+  if (total > BUZZER_NOTAS_MAX)
+    total = BUZZER_NOTAS_MAX;
+  memcpy(notas_ram, notas, total * sizeof *notas);
+  melodia = notas = notas_ram;
+  total_notas = total;
+  repeticoes_restantes = repeticoes;
+  nota_atual = 0;
+  hal_pwm_tom(buzzer_pin, notas[0].freq_hz);
+  alarme = hal_alarme_em_ms(notas[0].dur_ms, proximo_passo, NULL);
+}
+
+void buzzer_parar(void) {
+  if (alarme > 0)
+    hal_alarme_cancelar(alarme);
+  alarme = 0;
+  melodia = NULL;
+  hal_pwm_tom(buzzer_pin, 0);
+}
+
+bool buzzer_tocando(void) {
+  return melodia != NULL;
+}
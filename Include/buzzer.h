@@ -0,0 +1,21 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include "hal.h"
+
+// Sequenciador de tons em segundo plano: o PWM é configurado uma única vez e, a cada passo da
+// melodia, um alarme de hardware troca apenas os registradores de wrap e nível do slice (hal_pwm_tom).
+
+#define BUZZER_NOTAS_MAX 8 // Notas de uma melodia; as demais são ignoradas
+
+typedef struct {
+  uint16_t freq_hz; // 0 = pausa
+  uint16_t dur_ms;
+} nota_t;
+
+void buzzer_init(uint pin);
+void buzzer_tocar(const nota_t *notas, uint8_t total, uint8_t repeticoes);
+void buzzer_parar(void);
+bool buzzer_tocando(void);
+
+#endif
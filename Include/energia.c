@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include "energia.h"
+#include "agenda.h"
+
+static energia_modo_t modo = ENERGIA_NORMAL;
+static uint64_t modo_desde_us, modo_dormindo_desde_us; // Início do modo atual (relógio e sono da agenda)
+static uint64_t modo_us[ENERGIA_MODOS], dormindo_us[ENERGIA_MODOS];
+static uint32_t trocas, amostras;
+
+// Escritos só pelo núcleo 1
+static tela_t tela = TELA_LIGADA;
+static uint64_t tela_desde_us, tela_us[TELA_ESTADOS];
+
+static volatile bool atividade; // Sinalizada pelos botões
+static uint64_t ultima_atividade_us;
+
+void energia_init(void) {
+  modo_desde_us = tela_desde_us = ultima_atividade_us = hal_tempo_us();
+  modo_dormindo_desde_us = agenda_tempo_dormindo_us();
+}
+
+// Fecha a contagem do modo atual e troca o relógio do sistema
+void energia_modo(energia_modo_t novo) {
+  if (novo == modo)
+    return;
+  uint64_t agora = hal_tempo_us(), dormindo = agenda_tempo_dormindo_us();
+  modo_us[modo] += agora - modo_desde_us;
+  dormindo_us[modo] += dormindo - modo_dormindo_desde_us;
+  modo_desde_us = agora;
+  modo_dormindo_desde_us = dormindo;
+  modo = novo;
+  trocas++;
+  hal_relogio_economia(novo == ENERGIA_ECONOMIA);
+}
+
+energia_modo_t energia_modo_atual(void) {
+  return modo;
+}
+
+void energia_tela(tela_t nova) {
+  uint64_t agora = hal_tempo_us();
+  tela_us[tela] += agora - tela_desde_us;
+  tela_desde_us = agora;
+  tela = nova;
+}
+
+void energia_atividade(void) {
+  atividade = true;
+}
+
+bool energia_atividade_pendente(void) {
+  if (!atividade)
+    return false;
+  atividade = false;
+  ultima_atividade_us = hal_tempo_us();
+  return true;
+}
+
+uint64_t energia_ultima_atividade_us(void) {
+  return ultima_atividade_us;
+}
+
+void energia_amostra(void) {
+  amostras++;
+}
+
+void energia_residencia(energia_residencia_t *r) {
+  uint64_t agora = hal_tempo_us();
+  for (int m = 0; m < ENERGIA_MODOS; ++m) {
+    r->modo_us[m] = modo_us[m];
+    r->dormindo_us[m] = dormindo_us[m];
+  }
+  r->modo_us[modo] += agora - modo_desde_us;
+  r->dormindo_us[modo] += agenda_tempo_dormindo_us() - modo_dormindo_desde_us;
+  for (int t = 0; t < TELA_ESTADOS; ++t)
+    r->tela_us[t] = tela_us[t];
+  r->tela_us[tela] += agora - tela_desde_us;
+  r->trocas_modo = trocas;
+  r->amostras = amostras;
+}
+
+// Residência por modo e por estado da tela e carga estimada (uA x us, convertida para mAh e uC)
+void energia_relatorio(void) {
+  static const char *const modos[] = {"normal", "economia"};
+  static const uint32_t ua_executando[] = {ENERGIA_UA_EXECUTANDO, ENERGIA_UA_EXECUTANDO_ECONOMIA};
+  static const uint32_t ua_dormindo[] = {ENERGIA_UA_DORMINDO, ENERGIA_UA_DORMINDO_ECONOMIA};
+  static const uint32_t ua_tela[] = {ENERGIA_UA_TELA_LIGADA, ENERGIA_UA_TELA_ESCURECIDA, ENERGIA_UA_TELA_APAGADA};
+
+  energia_residencia_t r;
+  energia_residencia(&r);
+  uint64_t carga = 0, total_us = 0; // uA x us
+  printf("%-12s %10s %9s\n", "energia", "tempo_s", "dormindo%");
+  for (int m = 0; m < ENERGIA_MODOS; ++m) {
+    printf("%-12s %10lu %9lu\n", modos[m], (unsigned long)(r.modo_us[m] / 1000000),
+           (unsigned long)(r.modo_us[m] ? r.dormindo_us[m] * 100 / r.modo_us[m] : 0));
+    carga += (r.modo_us[m] - r.dormindo_us[m]) * ua_executando[m] + r.dormindo_us[m] * ua_dormindo[m];
+    total_us += r.modo_us[m];
+  }
+  for (int t = 0; t < TELA_ESTADOS; ++t)
+    carga += r.tela_us[t] * ua_tela[t];
+  printf("Tela: ligada %lu s, escurecida %lu s, apagada %lu s\n", (unsigned long)(r.tela_us[TELA_LIGADA] / 1000000),
+         (unsigned long)(r.tela_us[TELA_ESCURECIDA] / 1000000), (unsigned long)(r.tela_us[TELA_APAGADA] / 1000000));
+  printf("Carga estimada: %lu mAh, media %lu uA, %lu uC por amostra (%lu amostras, %lu trocas de modo)\n",
+         (unsigned long)(carga / 3600000000000ull), (unsigned long)(total_us ? carga / total_us : 0),
+         (unsigned long)(r.amostras ? carga / 1000000 / r.amostras : 0), (unsigned long)r.amostras,
+         (unsigned long)r.trocas_modo);
+}
@@ -0,0 +1,57 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "hal.h"
+
+// Gerência de energia: modo normal (amostragem a cada 100 ms, clk_sys cheio) e modo economia
+// (amostragem espaçada, clk_sys a 48 MHz, núcleos dormindo entre as amostras). Os botões acordam o
+// núcleo 0 pela própria interrupção. Contadores de residência por modo e por estado da tela
+// alimentam uma estimativa da carga consumida por amostra.
+
+#define ENERGIA_OCIOSO_MS 60000 // Sem botões e sem rega por este tempo: entra em economia
+#define ENERGIA_PERIODO_ECONOMIA_MS 5000 // Período das tarefas de controle em economia
+#define ENERGIA_ESCURECER_MS 30000 // Tela com contraste mínimo após este tempo sem botões
+#define ENERGIA_APAGAR_MS 120000 // Tela desligada
+
+// Corrente média estimada por estado (uA): referências típicas do RP2040 e de um SSD1306 de 0,96".
+// Calibre com uma medição da placa para que a carga por amostra reflita o hardware real.
+#define ENERGIA_UA_EXECUTANDO 24000 // 125 MHz
+#define ENERGIA_UA_DORMINDO 11000 // WFE a 125 MHz
+#define ENERGIA_UA_EXECUTANDO_ECONOMIA 11000 // 48 MHz, PLL do sistema desligado
+#define ENERGIA_UA_DORMINDO_ECONOMIA 6000
+#define ENERGIA_UA_TELA_LIGADA 12000
+#define ENERGIA_UA_TELA_ESCURECIDA 4000
+#define ENERGIA_UA_TELA_APAGADA 10
+
+typedef enum {
+  ENERGIA_NORMAL,
+  ENERGIA_ECONOMIA,
+  ENERGIA_MODOS
+} energia_modo_t;
+
+typedef enum {
+  TELA_LIGADA,
+  TELA_ESCURECIDA,
+  TELA_APAGADA,
+  TELA_ESTADOS
+} tela_t;
+
+typedef struct {
+  uint64_t modo_us[ENERGIA_MODOS]; // Tempo total em cada modo
+  uint64_t dormindo_us[ENERGIA_MODOS]; // Parte desse tempo com o núcleo 0 dormindo
+  uint64_t tela_us[TELA_ESTADOS];
+  uint32_t trocas_modo, amostras;
+} energia_residencia_t;
+
+void energia_init(void);
+void energia_modo(energia_modo_t modo); // Núcleo 0
+energia_modo_t energia_modo_atual(void);
+void energia_tela(tela_t tela); // Núcleo 1, ao aplicar o estado da tela
+void energia_atividade(void); // Pode ser chamada de interrupção (botões)
+bool energia_atividade_pendente(void); // Consome o aviso e marca o instante da atividade
+uint64_t energia_ultima_atividade_us(void);
+void energia_amostra(void);
+void energia_residencia(energia_residencia_t *r); // Contadores até o instante atual
+void energia_relatorio(void);
+
+#endif
@@ -0,0 +1,36 @@
+#include "estado.h"
+
+static estado_t fila[ESTADO_FILA];
+static volatile uint32_t cabeca; // Escrito apenas pelo produtor (núcleo 0)
+static volatile uint32_t cauda; // Escrito apenas pelo consumidor (núcleo 1)
+static volatile uint32_t descartados;
+
+// Publica um retrato. Com a fila cheia (consumidor atrasado) o retrato é descartado em vez de esperar.
+bool estado_publicar(const estado_t *e) {
+  uint32_t c = cabeca;
+  if (c - cauda >= ESTADO_FILA) {
+    descartados = descartados + 1;
+    return false;
+  }
+  fila[c & (ESTADO_FILA - 1)] = *e;
+  hal_barreira(); // O conteúdo precisa estar visível antes do novo índice
+  cabeca = c + 1;
+  hal_sinalizar(); // Acorda o núcleo 1 se estiver em hal_dormir
+  return true;
+}
+
+// Copia o retrato mais recente, descartando os intermediários. Retorna false se não houver novidade.
+bool estado_consumir(estado_t *e) {
+  uint32_t c = cabeca;
+  if (c == cauda)
+    return false;
+  hal_barreira();
+  *e = fila[(c - 1) & (ESTADO_FILA - 1)];
+  hal_barreira(); // Leitura concluída antes de liberar as posições para o produtor
+  cauda = c;
+  return true;
+}
+
+uint32_t estado_descartados(void) {
+  return descartados;
+}
@@ -0,0 +1,42 @@
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#include "hal.h"
+#include "zonas.h"
+
+// Retrato do estado de controle publicado pelo núcleo 0 (sensores, relé, alerta) e consumido pelo
+// núcleo 1 (display, matriz de LEDs, telemetria). A troca é uma fila SPSC sem travas: cada índice
+// é escrito por um único núcleo, então o controle nunca espera pelo núcleo de interface.
+
+#define ESTADO_FILA 4 // Potência de 2
+
+typedef enum {
+  ALERTA_NENHUM,
+  ALERTA_VERIFICANDO,
+  ALERTA_CANCELADO,
+  ALERTA_TOCANDO,
+  ALERTA_DESLIGADO,
+  ALERTA_SENSOR // Sensor com defeito acabou de ser detectado (ver estatistica.h)
+} alerta_t;
+
+typedef struct {
+  uint32_t sequencia; // Número do retrato, incrementado a cada publicação
+  uint16_t adc_luz; // Leitura filtrada (12 bits)
+  uint8_t intensidade; // Nível da matriz de LEDs (0-255)
+  uint8_t zonas, zona; // Total de zonas e zona exibida na página atual do display
+  uint16_t adc_umidade[ZONAS_MAX]; // Leituras por zona (12 bits ou ZONA_SEM_LEITURA)
+  uint16_t umidade[ZONAS_MAX]; // Umidade do solo em %, Q8.8
+  int8_t ideal[ZONAS_MAX], tempo_rega[ZONAS_MAX];
+  int8_t irrigando; // Zona com o relé ligado (-1 = nenhuma)
+  alerta_t alerta;
+  const char *msg_rega; // Estado da zona exibida; texto constante (flash), seguro de compartilhar entre os núcleos
+  uint8_t tela; // tela_t (energia.h): ligada, escurecida ou apagada
+  uint16_t falhas; // Sensores com defeito: bit z = umidade da zona z, bit ZONAS_MAX = luminosidade
+  uint8_t grafico; // Escala do gráfico na tela mais 1 (ver grafico.h); 0 = tela de valores
+} estado_t;
+
+bool estado_publicar(const estado_t *e);
+bool estado_consumir(estado_t *e);
+uint32_t estado_descartados(void);
+
+#endif
@@ -0,0 +1,105 @@
+#include "estatistica.h"
+
+#define ADC_MAX 4095
+
+void estat_init(estat_t *s) {
+  *s = (estat_t){0};
+}
+
+// Raiz quadrada inteira, bit a bit (uma por janela fechada)
+static uint32_t raiz(uint64_t v) {
+  uint64_t r = 0, bit = (uint64_t)1 << 62;
+  while (bit > v)
+    bit >>= 2;
+  for (; bit; bit >>= 2) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+  }
+  return r;
+}
+
+// Fecha a janela: desvio padrão, inclinação entre os meios desta janela e da anterior e trilho
+static void fechar(estat_t *s, uint64_t agora_us) {
+  uint64_t meio = (s->inicio_us + agora_us) / 2;
+  if (s->janelas && meio > s->meio_anterior_us) {
+    int64_t diferenca = s->media_q16 - s->media_anterior_q16;
+    int32_t nova = diferenca * 3600000000ll / (int64_t)(meio - s->meio_anterior_us) / 256; // Q16 -> Q8 por hora
+    s->inclinacao_q8 = s->janelas == 1 ? nova : s->inclinacao_q8 + (nova - s->inclinacao_q8) / ESTAT_EWMA_DIVISOR;
+  }
+  s->desvio_q8 = s->n > 1 ? raiz(s->m2_q16 / (s->n - 1)) : 0; // Raiz de Q16 = Q8
+  bool trilho = s->max <= ESTAT_TRILHO || s->min >= ADC_MAX - ESTAT_TRILHO;
+  s->no_trilho = trilho ? (s->no_trilho < 255 ? s->no_trilho + 1 : 255) : 0;
+  s->media_anterior_q16 = s->media_q16;
+  s->meio_anterior_us = meio;
+  ++s->janelas;
+  s->n = 0;
+  s->media_q16 = 0;
+  s->m2_q16 = 0;
+}
+
+bool estat_amostra(estat_t *s, uint16_t adc, uint64_t agora_us) {
+  if (s->iguais && adc == s->ultima) {
+    ++s->iguais;
+  } else {
+    s->ultima = adc;
+    s->iguais = 1;
+    s->mudou_us = agora_us;
+  }
+
+  if (s->n == 0) {
+    s->inicio_us = agora_us;
+    s->min = s->max = adc;
+  }
+  if (adc < s->min)
+    s->min = adc;
+  if (adc > s->max)
+    s->max = adc;
+  // Welford: a média anda 1/n do desvio e M2 soma o produto dos desvios antes e depois do passo
+  int32_t x = (int32_t)adc << 16;
+  int32_t delta = x - s->media_q16;
+  s->media_q16 += delta / (int32_t)++s->n;
+  s->m2_q16 += ((int64_t)delta * (x - s->media_q16)) >> 16;
+
+  bool fechou = agora_us - s->inicio_us >= ESTAT_JANELA_MS * 1000ull;
+  if (fechou)
+    fechar(s, agora_us);
+  bool preso = s->iguais >= ESTAT_PRESO_AMOSTRAS && agora_us - s->mudou_us >= ESTAT_PRESO_MS * 1000ull;
+  s->falha = s->no_trilho >= ESTAT_TRILHO_JANELAS ? ESTAT_FALHA_TRILHO : preso ? ESTAT_FALHA_PRESO : ESTAT_FALHA_NENHUMA;
+  return fechou;
+}
+
+uint16_t estat_media(const estat_t *s) {
+  return (s->media_anterior_q16 + (1 << 15)) >> 16;
+}
+
+bool estat_estavel(const estat_t *s, uint32_t desvio_max_q8, int32_t inclinacao_max_q8) {
+  int32_t inclinacao = s->inclinacao_q8 < 0 ? -s->inclinacao_q8 : s->inclinacao_q8;
+  return s->janelas >= 2 && s->desvio_q8 <= desvio_max_q8 && inclinacao <= inclinacao_max_q8;
+}
+
+int32_t estat_tempo_ate(const estat_t *s, uint16_t limiar) {
+  if (s->janelas < 2)
+    return -1;
+  int32_t distancia = ((int32_t)limiar << 8) - (s->media_anterior_q16 >> 8); // Q8
+  if (distancia == 0)
+    return 0;
+  if (s->inclinacao_q8 == 0 || (distancia > 0) != (s->inclinacao_q8 > 0))
+    return -1; // Parada, se afastando ou já do outro lado
+  int64_t t = (int64_t)distancia * 3600 / s->inclinacao_q8;
+  return t > INT32_MAX ? INT32_MAX : (int32_t)t;
+}
+
+const char *estat_falha_nome(estat_falha_t falha) {
+  switch (falha) {
+  case ESTAT_FALHA_TRILHO:
+    return "no trilho";
+  case ESTAT_FALHA_PRESO:
+    return "preso";
+  default:
+    return "ok";
+  }
+}
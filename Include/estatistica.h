@@ -0,0 +1,56 @@
+#ifndef ESTATISTICA_H
+#define ESTATISTICA_H
+
+#include "hal.h"
+
+// Estatística incremental de uma leitura do ADC (12 bits), uma amostra por vez e sem guardar o
+// histórico: média e variância de Welford em ponto fixo por janela de ESTAT_JANELA_MS, inclinação
+// suavizada por EWMA entre as médias de janelas seguidas e detecção de sensor com defeito:
+//  - trilho: janelas inteiras junto de 0 ou de 4095 (fio solto com pull-up/pull-down, curto);
+//  - preso: exatamente a mesma leitura por ESTAT_PRESO_MS e ESTAT_PRESO_AMOSTRAS (ADC externo
+//    travado, multiplexador sem trocar de canal). O ruído de poucas contagens que sobra depois da
+//    média do oversampling basta para uma leitura viva mudar bem antes disso.
+// As janelas são por tempo, não por número de amostras: o período de leitura pode mudar.
+
+#define ESTAT_JANELA_MS 60000
+#define ESTAT_EWMA_DIVISOR 4 // Peso de cada inclinação nova na média móvel: 1/4
+#define ESTAT_TRILHO 8 // Contagens a partir de 0 ou de 4095 que contam como trilho
+#define ESTAT_TRILHO_JANELAS 2 // Janelas seguidas no trilho até a falha
+#define ESTAT_PRESO_MS 600000
+#define ESTAT_PRESO_AMOSTRAS 100
+
+typedef enum {
+  ESTAT_FALHA_NENHUMA,
+  ESTAT_FALHA_TRILHO,
+  ESTAT_FALHA_PRESO
+} estat_falha_t;
+
+typedef struct {
+  // Janela em formação: média em Q16.16 contagens e soma dos quadrados dos desvios em Q16
+  uint32_t n;
+  int32_t media_q16;
+  int64_t m2_q16;
+  uint16_t min, max;
+  uint64_t inicio_us;
+  // Última janela fechada
+  int32_t media_anterior_q16;
+  uint64_t meio_anterior_us;
+  uint32_t desvio_q8; // Desvio padrão em contagens, Q8
+  int32_t inclinacao_q8; // Contagens por hora, Q8 (EWMA)
+  uint32_t janelas; // Janelas fechadas; a inclinação vale a partir da segunda
+  // Defeitos
+  uint16_t ultima;
+  uint32_t iguais; // Amostras seguidas iguais a ultima
+  uint64_t mudou_us;
+  uint8_t no_trilho; // Janelas seguidas inteiras no trilho
+  estat_falha_t falha;
+} estat_t;
+
+void estat_init(estat_t *s);
+bool estat_amostra(estat_t *s, uint16_t adc, uint64_t agora_us); // true quando fecha uma janela
+uint16_t estat_media(const estat_t *s); // Média da última janela fechada, em contagens
+bool estat_estavel(const estat_t *s, uint32_t desvio_max_q8, int32_t inclinacao_max_q8);
+int32_t estat_tempo_ate(const estat_t *s, uint16_t limiar); // s até a média cruzar o limiar na inclinação atual; -1 se não se aproxima
+const char *estat_falha_nome(estat_falha_t falha);
+
+#endif
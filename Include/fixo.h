@@ -0,0 +1,48 @@
+#ifndef FIXO_H
+#define FIXO_H
+
+#include <stdint.h>
+
+// Aritmética em ponto fixo para o laço de controle (o Cortex-M0+ não tem FPU).
+// Percentuais usam Q8.8: 0..100% -> 0..25600, com 1/256 % de resolução.
+
+#define PCT_Q8(p) ((int32_t)(p) << 8)
+
+// Leitura de 12 bits (0..4095) -> percentual Q8.8. 409701 = round(25600 / 4095 * 2^16)
+static inline uint16_t adc_para_pct_q8(uint16_t adc) {
+  return ((uint32_t)adc * 409701u + 32768u) >> 16;
+}
+
+// Percentual inteiro (0..100) -> leitura de 12 bits, para comparar limiares com leituras brutas
+static inline uint16_t pct_para_adc(uint8_t pct) {
+  return ((uint32_t)pct * 4095u + 50u) / 100u;
+}
+
+// Leitura de 12 bits -> fração Q0.8 (0..255). 4081 = round(255 / 4095 * 2^16)
+static inline uint8_t adc_para_nivel(uint16_t adc) {
+  return ((uint32_t)adc * 4081u + 32768u) >> 16;
+}
+
+// Parte inteira arredondada de um valor Q8.8
+static inline uint16_t q8_arredonda(uint16_t q8) {
+  return (q8 + 128u) >> 8;
+}
+
+// Converte um inteiro sem sinal em texto decimal seguido de um sufixo opcional ('\0' para nenhum).
+// Substitui sprintf no laço principal; retorna o número de caracteres escritos (sem o terminador).
+static inline uint8_t fmt_uint(char *s, uint32_t v, char sufixo) {
+  char tmp[10];
+  uint8_t n = 0, len = 0;
+  do {
+    tmp[n++] = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  while (n)
+    s[len++] = tmp[--n];
+  if (sufixo)
+    s[len++] = sufixo;
+  s[len] = '\0';
+  return len;
+}
+
+#endif
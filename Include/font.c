@@ -0,0 +1,147 @@
+#include "font.h"
+
+// Fonte 6x8 para os caracteres de 32 a 126 na tabela ASCII: 6 colunas por caractere, a última em branco.
+// Constante: fica na flash (XIP) e não é copiada para a SRAM.
+static const uint8_t glyphs_6x8[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Espaço
+    0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, // !
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x00, // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00, // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, 0x00, // %
+    0x36, 0x49, 0x56, 0x20, 0x50, 0x00, // &
+    0x00, 0x00, 0x05, 0x03, 0x00, 0x00, // '
+    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, // (
+    0x00, 0x41, 0x22, 0x1C, 0x00, 0x00, // )
+    0x14, 0x08, 0x3E, 0x08, 0x14, 0x00, // *
+    0x08, 0x08, 0x3E, 0x08, 0x08, 0x00, // +
+    0x00, 0x00, 0xA0, 0x60, 0x00, 0x00, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, // -
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x00, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, 0x00, // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, // 0
+    0x00, 0x42, 0x7F, 0x40, 0x00, 0x00, // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, 0x00, // 2
+    0x21, 0x41, 0x49, 0x4D, 0x33, 0x00, // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10, 0x00, // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, 0x00, // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30, 0x00, // 6
+    0x03, 0x01, 0x71, 0x09, 0x07, 0x00, // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E, 0x00, // 9
+    0x00, 0x00, 0x66, 0x66, 0x00, 0x00, // :
+    0x00, 0x00, 0x56, 0x36, 0x00, 0x00, // ;
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00, // =
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x00, // >
+    0x02, 0x01, 0x59, 0x09, 0x06, 0x00, // ?
+    0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x00, // @
+    0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00, // A
+    0x7F, 0x49, 0x49, 0x49, 0x36, 0x00, // B
+    0x3E, 0x41, 0x41, 0x41, 0x22, 0x00, // C
+    0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00, // D
+    0x7F, 0x49, 0x49, 0x49, 0x41, 0x00, // E
+    0x7F, 0x09, 0x09, 0x09, 0x01, 0x00, // F
+    0x3E, 0x41, 0x41, 0x51, 0x72, 0x00, // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, // H
+    0x00, 0x41, 0x7F, 0x41, 0x00, 0x00, // I
+    0x20, 0x40, 0x41, 0x3F, 0x01, 0x00, // J
+    0x7F, 0x08, 0x14, 0x22, 0x41, 0x00, // K
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x00, // L
+    0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x00, // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00, // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, // O
+    0x7F, 0x09, 0x09, 0x09, 0x06, 0x00, // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00, // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46, 0x00, // R
+    0x26, 0x49, 0x49, 0x49, 0x32, 0x00, // S
+    0x01, 0x01, 0x7F, 0x01, 0x01, 0x00, // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00, // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00, // V
+    0x3F, 0x40, 0x30, 0x40, 0x3F, 0x00, // W
+    0x63, 0x14, 0x08, 0x14, 0x63, 0x00, // X
+    0x03, 0x04, 0x78, 0x04, 0x03, 0x00, // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, 0x00, // Z
+    0x00, 0x7F, 0x41, 0x41, 0x41, 0x00, // [
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, /*\*/
+    0x00, 0x41, 0x41, 0x41, 0x7F, 0x00, // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x00, // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // _ 
+    0x00, 0x03, 0x05, 0x00, 0x00, 0x00, // `
+    0x20, 0x54, 0x54, 0x54, 0x78, 0x00, // a
+    0x7F, 0x28, 0x44, 0x44, 0x38, 0x00, // b
+    0x38, 0x44, 0x44, 0x44, 0x28, 0x00, // c
+    0x38, 0x44, 0x44, 0x28, 0x7F, 0x00, // d
+    0x38, 0x54, 0x54, 0x54, 0x18, 0x00, // e
+    0x00, 0x08, 0x7E, 0x09, 0x02, 0x00, // f
+    0x18, 0x54, 0x54, 0x54, 0x3C, 0x00, // g
+    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, // h
+    0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, // i
+    0x20, 0x40, 0x40, 0x3D, 0x00, 0x00, // j
+    0x7F, 0x10, 0x28, 0x44, 0x00, 0x00, // k
+    0x00, 0x41, 0x7F, 0x40, 0x00, 0x00, // l
+    0x7C, 0x04, 0x78, 0x04, 0x78, 0x00, // m
+    0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, // n
+    0x38, 0x44, 0x44, 0x44, 0x38, 0x00, // o
+    0xFC, 0x18, 0x24, 0x24, 0x18, 0x00, // p
+    0x18, 0x24, 0x24, 0x18, 0xFC, 0x00, // q
+    0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, // r
+    0x48, 0x54, 0x54, 0x54, 0x24, 0x00, // s
+    0x04, 0x04, 0x3F, 0x44, 0x24, 0x00, // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00, // v
+    0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00, // w
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x00, // x
+    0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00, // y
+    0x44, 0x64, 0x54, 0x4C, 0x44, 0x00, // z
+    0x00, 0x08, 0x36, 0x41, 0x00, 0x00, // {
+    0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, // |
+    0x00, 0x41, 0x36, 0x08, 0x00, 0x00, // }
+    0x02, 0x01, 0x02, 0x04, 0x02, 0x00, // ~
+};
+
+// Versão proporcional da mesma fonte: primeira coluna desenhada (4 bits altos) e largura (4 bits baixos)
+// de cada caractere, sem as colunas em branco das bordas. Os algarismos mantêm a largura cheia para
+// que leituras numéricas não mudem de tamanho com o valor.
+static const uint8_t spans_prop[] = {
+    0x03, 0x21, 0x13, 0x05, 0x05, 0x05, 0x05, 0x22, // Espaço ! " # $ % & '
+    0x13, 0x13, 0x05, 0x05, 0x22, 0x05, 0x22, 0x05, // ( ) * + , - . /
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // 0 1 2 3 4 5 6 7
+    0x05, 0x05, 0x22, 0x22, 0x14, 0x05, 0x14, 0x05, // 8 9 : ; < = > ?
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // @ A B C D E F G
+    0x05, 0x13, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // H I J K L M N O
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // P Q R S T U V W
+    0x05, 0x05, 0x05, 0x14, 0x05, 0x14, 0x05, 0x05, // X Y Z [ \ ] ^ _
+    0x12, 0x05, 0x05, 0x05, 0x05, 0x05, 0x14, 0x05, // ` a b c d e f g
+    0x05, 0x13, 0x04, 0x04, 0x13, 0x05, 0x05, 0x05, // h i j k l m n o
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, // p q r s t u v w
+    0x05, 0x05, 0x05, 0x13, 0x21, 0x13, 0x05, // x y z { | } ~
+};
+
+const font_t font_6x8 = {glyphs_6x8, NULL, 6, 0, ' ', '~'};
+const font_t font_prop = {glyphs_6x8, spans_prop, 6, 1, ' ', '~'};
+
+const uint8_t *font_glyph(const font_t *font, char c, uint8_t *width) {
+  if (c < font->first || c > font->last)
+    c = font->first;
+  uint8_t i = c - font->first;
+  const uint8_t *glyph = &font->glyphs[i * font->cell];
+  if (!font->spans) {
+    if (width)
+      *width = font->cell;
+    return glyph;
+  }
+  if (width)
+    *width = font->spans[i] & 0x0F;
+  return glyph + (font->spans[i] >> 4);
+}
+
+uint16_t font_text_width(const font_t *font, const char *str, uint8_t scale) {
+  uint16_t width = 0;
+  for (; *str; ++str) {
+    uint8_t w;
+    font_glyph(font, *str, &w);
+    width += w + font->spacing;
+  }
+  return width * scale;
+}
@@ -0,0 +1,109 @@
+#include "grafico.h"
+
+#define VAZIA_MIN 0xFF // Coluna sem amostras: mínimo acima do máximo
+#define VAZIA_MAX 0
+
+typedef struct {
+  uint8_t min[GRAFICO_COLUNAS], max[GRAFICO_COLUNAS]; // Anel de colunas fechadas
+  uint8_t acum_min, acum_max; // Coluna em formação
+  uint8_t vazias; // Colunas seguidas sem amostras (só na escala mais fina)
+} grafico_serie_t;
+
+static const uint32_t passo_ms[GRAFICO_ESCALAS] = {GRAFICO_MINUTOS_MS, GRAFICO_HORAS_MS, GRAFICO_DIAS_MS};
+static const char *const nomes[GRAFICO_ESCALAS] = {"16 min", "8 h", "4 dias"};
+
+static grafico_serie_t series[GRAFICO_ESCALAS][GRAFICO_SERIES];
+static uint64_t coluna_atual[GRAFICO_ESCALAS]; // Índice (t / passo) da coluna em formação
+static uint32_t fechadas[GRAFICO_ESCALAS];
+static uint8_t cabeca[GRAFICO_ESCALAS]; // Próxima posição do anel, comum a todas as séries da escala
+static bool iniciado;
+
+static void esvaziar(grafico_serie_t *s) {
+  s->acum_min = VAZIA_MIN;
+  s->acum_max = VAZIA_MAX;
+}
+
+void grafico_init(void) {
+  for (uint8_t e = 0; e < GRAFICO_ESCALAS; ++e) {
+    for (uint8_t s = 0; s < GRAFICO_SERIES; ++s) {
+      for (uint8_t i = 0; i < GRAFICO_COLUNAS; ++i) {
+        series[e][s].min[i] = VAZIA_MIN;
+        series[e][s].max[i] = VAZIA_MAX;
+      }
+      esvaziar(&series[e][s]);
+    }
+    fechadas[e] = cabeca[e] = 0;
+  }
+  iniciado = false;
+}
+
+static inline void acumular(grafico_serie_t *s, uint8_t min, uint8_t max) {
+  if (min < s->acum_min)
+    s->acum_min = min;
+  if (max > s->acum_max)
+    s->acum_max = max;
+}
+
+// Fecha a coluna em formação da escala: entra no anel e é dobrada na coluna da escala seguinte
+static void fechar(uint8_t e) {
+  uint8_t i = cabeca[e], anterior = (i + GRAFICO_COLUNAS - 1) % GRAFICO_COLUNAS;
+  for (uint8_t s = 0; s < GRAFICO_SERIES; ++s) {
+    grafico_serie_t *serie = &series[e][s];
+    if (e == 0 && serie->acum_min <= serie->acum_max) {
+      serie->vazias = 0;
+    } else if (e == 0 && ++serie->vazias <= GRAFICO_REPETIR) {
+      serie->acum_min = serie->min[anterior]; // Retratos espaçados: repete a coluna anterior
+      serie->acum_max = serie->max[anterior];
+    }
+    serie->min[i] = serie->acum_min;
+    serie->max[i] = serie->acum_max;
+    if (e + 1 < GRAFICO_ESCALAS && serie->acum_min <= serie->acum_max)
+      acumular(&series[e + 1][s], serie->acum_min, serie->acum_max);
+    esvaziar(serie);
+  }
+  cabeca[e] = (i + 1) % GRAFICO_COLUNAS;
+  ++fechadas[e];
+}
+
+// As escalas são fechadas da mais fina para a mais grossa: a última coluna fina de um intervalo
+// já está dobrada quando a coluna grossa fecha. Um salto no tempo entra como colunas vazias.
+void grafico_avancar(uint64_t t_ms) {
+  for (uint8_t e = 0; e < GRAFICO_ESCALAS; ++e) {
+    uint64_t coluna = t_ms / passo_ms[e];
+    if (!iniciado) {
+      coluna_atual[e] = coluna;
+      continue;
+    }
+    for (uint8_t n = 0; coluna_atual[e] < coluna && n < GRAFICO_COLUNAS; ++n) {
+      fechar(e);
+      ++coluna_atual[e];
+    }
+    coluna_atual[e] = coluna;
+  }
+  iniciado = true;
+}
+
+void grafico_amostra(uint8_t serie, uint16_t valor) {
+  if (serie >= GRAFICO_SERIES)
+    return;
+  uint8_t v = valor > 100 ? 100 : valor;
+  acumular(&series[0][serie], v, v);
+}
+
+uint32_t grafico_colunas(uint8_t escala) {
+  return escala < GRAFICO_ESCALAS ? fechadas[escala] : 0;
+}
+
+bool grafico_coluna(uint8_t serie, uint8_t escala, uint8_t idade, uint8_t *min, uint8_t *max) {
+  if (serie >= GRAFICO_SERIES || escala >= GRAFICO_ESCALAS || idade >= GRAFICO_COLUNAS)
+    return false;
+  uint8_t i = (cabeca[escala] + GRAFICO_COLUNAS - 1 - idade) % GRAFICO_COLUNAS;
+  const grafico_serie_t *s = &series[escala][serie];
+  *min = s->min[i];
+  *max = s->max[i];
+  return *min <= *max;
+}
+
+const char *grafico_escala_nome(uint8_t escala) {
+  return escala < GRAFICO_ESCALAS ? nomes[escala] : "";
+}
@@ -0,0 +1,35 @@
+#ifndef GRAFICO_H
+#define GRAFICO_H
+
+#include "hal.h"
+#include "zonas.h"
+
+// Histórico de curto prazo para o gráfico do display: umidade de cada zona e luminosidade em
+// anéis de tamanho fixo, uma coluna por posição, em três escalas de tempo. Cada coluna guarda o
+// mínimo e o máximo das amostras do seu intervalo (decimação por mín/máx: um pico curto continua
+// visível mesmo quando uma coluna cobre uma hora). As colunas de uma escala alimentam a seguinte,
+// então cada amostra é tratada uma única vez.
+//
+// Tudo roda no núcleo 1, a partir dos retratos do estado; nada vai para a flash (ver registro.h).
+// Com o controle espaçando os retratos (cadência adaptativa, ver jardim.h), uma coluna da escala
+// mais fina pode ficar sem amostra: até GRAFICO_REPETIR colunas seguidas repetem a anterior.
+
+#define GRAFICO_COLUNAS 96 // Colunas por escala: a largura da área do gráfico na tela
+#define GRAFICO_ESCALAS 3
+#define GRAFICO_LUZ ZONAS_MAX // Série da luminosidade, depois das zonas
+#define GRAFICO_SERIES (ZONAS_MAX + 1)
+#define GRAFICO_REPETIR 6 // Colunas vazias seguidas preenchidas com a anterior; depois, lacuna
+
+// Tempo de uma coluna em cada escala; cada uma é múltipla da anterior
+#define GRAFICO_MINUTOS_MS 10000 // 96 colunas = 16 min
+#define GRAFICO_HORAS_MS 300000 // 8 h
+#define GRAFICO_DIAS_MS 3600000 // 4 dias
+
+void grafico_init(void);
+void grafico_avancar(uint64_t t_ms); // Fecha as colunas cujo intervalo terminou; antes das amostras
+void grafico_amostra(uint8_t serie, uint16_t valor); // Valor em % (acima de 100 fica em 100)
+uint32_t grafico_colunas(uint8_t escala); // Colunas fechadas desde o início: muda a cada coluna nova
+bool grafico_coluna(uint8_t serie, uint8_t escala, uint8_t idade, uint8_t *min, uint8_t *max); // idade 0 = mais recente; false sem amostras
+const char *grafico_escala_nome(uint8_t escala); // Período coberto pela tela inteira
+
+#endif
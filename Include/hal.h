@@ -0,0 +1,108 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Camada fina de abstração de hardware. Os módulos de controle, interface e drivers (agenda,
+// irrigacao, buzzer, estado, ssd1306, matriz_leds, jardim) só usam estas funções; hal_rp2040.c as
+// implementa com o SDK do Pico e host/hal_linux.c com um relógio virtual e periféricos simulados.
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Canais do ADC (GPIO = 26 + canal; o último é o sensor de temperatura interno, entrada 4)
+#define SENSOR_CANAL_LUZ 0 // LDR no GPIO26
+#define SENSOR_CANAL_UMIDADE 1 // Umidade do solo no GPIO27
+#define SENSOR_CANAL_MUX 2 // Saída do multiplexador analógico das zonas no GPIO28 (ver zonas.h)
+#define SENSOR_CANAL_TEMPERATURA 3
+#define SENSORES_CANAIS 4
+
+// Palavras de hal_i2c_dma seguem o registrador DATA_CMD do RP2040: byte nos bits 0-7, STOP no bit 9
+#define HAL_I2C_STOP 0x200u
+
+typedef int32_t hal_alarme_t;
+typedef int64_t (*hal_alarme_fn_t)(hal_alarme_t id, void *ctx); // Retorno como nos alarmes do SDK
+
+// Tempo
+uint64_t hal_tempo_us(void);
+void hal_dormir_ate(uint64_t prazo_us); // Até o prazo ou a próxima interrupção
+void hal_dormir(void); // Até a próxima interrupção ou sinal do outro núcleo
+
+// Ciclos do núcleo atual (SysTick de 24 bits no RP2040: diferenças valem até ~134 ms a 125 MHz)
+uint32_t hal_ciclos(void);
+uint32_t hal_ciclos_decorridos(uint32_t inicio); // Desde hal_ciclos() = inicio, tratando a volta do contador
+uint32_t hal_ciclos_por_us(void); // Muda com hal_relogio_economia
+
+// Sincronização
+void hal_barreira(void); // Barreira de memória entre os núcleos
+void hal_sinalizar(void); // Acorda o outro núcleo de hal_dormir
+uint32_t hal_trava(void); // Desabilita interrupções, devolvendo o estado anterior
+void hal_destrava(uint32_t estado);
+
+// GPIO
+void hal_gpio_saida(uint pino);
+void hal_gpio_put(uint pino, bool valor);
+bool hal_gpio_get(uint pino);
+void hal_gpio_entrada(uint pino); // Com pull-up
+
+// Alarmes de hardware (a função roda em contexto de interrupção; ver também a flash, abaixo)
+hal_alarme_t hal_alarme_em_ms(uint32_t ms, hal_alarme_fn_t fn, void *ctx);
+bool hal_alarme_cancelar(hal_alarme_t id);
+
+// Última leitura filtrada (12 bits) de um canal do ADC
+uint16_t hal_adc_ler(uint8_t canal);
+
+// Relógio do sistema: em economia o clk_sys cai para 48 MHz (PLL da USB) e o PLL do sistema é
+// desligado; I2C, PWM, UART e os PIO da matriz e da vazão, que dependem do clk_sys, são reajustados
+// pela própria HAL. Quem chama garante que nenhum envio por DMA (display, matriz) esteja em andamento (ver jardim.c).
+void hal_relogio_economia(bool economia);
+
+// I2C: inicialização (a taxa é reaplicada nas trocas de relógio), escrita e leitura bloqueantes com
+// prazo (HAL_I2C_PRAZO_US mais o tempo dos bytes: um barramento travado não prende o núcleo) e
+// escrita em segundo plano de palavras DATA_CMD
+#define HAL_I2C_PRAZO_US 1000
+void hal_i2c_init(i2c_inst_t *i2c, uint32_t baud);
+bool hal_i2c_escrever(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t total); // false sem resposta ou fora do prazo
+bool hal_i2c_ler(i2c_inst_t *i2c, uint8_t endereco, uint8_t *dados, size_t total); // false sem resposta ou fora do prazo
+void hal_i2c_dma(i2c_inst_t *i2c, uint8_t endereco, const uint16_t *palavras, size_t total);
+bool hal_i2c_ocupado(i2c_inst_t *i2c);
+
+// Matriz de LEDs WS2812. Uma fita: palavras GRB alinhadas à esquerda (programa matriz); várias, em
+// pinos consecutivos a partir de pino: bits de LED transpostos, um byte por bit (matriz_paralelo)
+void hal_leds_init(uint pino, uint8_t fitas);
+void hal_leds_enviar(const uint32_t *palavras, uint total);
+bool hal_leds_ocupado(void);
+
+// Sensor de vazão: pulsos contados por uma máquina de estados do pio1 (programa fluxo), sem a CPU
+void hal_fluxo_init(uint pino);
+uint32_t hal_fluxo_pulsos(void); // Total desde o init
+
+// Tom no buzzer via PWM (0 Hz = silêncio)
+void hal_pwm_init(uint pino);
+void hal_pwm_tom(uint pino, uint16_t freq_hz);
+
+// Flash (deslocamentos a partir do início da flash). Apagar e programar param a execução a partir
+// da flash nos dois núcleos enquanto duram: ~45 ms por setor, ~1 ms por página. Só o núcleo 1
+// grava; o núcleo 0 espera na RAM com as interrupções ligadas, e os alarmes dele disparam no
+// horário desde que a função do alarme e tudo o que ela chama (e lê) estejam na RAM
+// (__not_in_flash_func). As demais interrupções do núcleo 0 ficam pendentes até o fim da gravação.
+#define HAL_FLASH_SETOR 4096u
+#define HAL_FLASH_PAGINA 256u
+void hal_flash_pausavel(void); // No núcleo 0, depois de lançar o núcleo 1
+void hal_flash_apagar(uint32_t deslocamento); // Um setor
+void hal_flash_programar(uint32_t deslocamento, const uint8_t *pagina); // Uma página
+const uint8_t *hal_flash_ler(uint32_t deslocamento);
+
+// Serial (USB CDC): leitura sem espera (-1 = nada recebido), bytes que podem ser escritos sem
+// bloquear e escrita binária sem tradução de \n
+int hal_serial_ler(void);
+size_t hal_serial_livre(void);
+void hal_serial_escrever_bruto(const uint8_t *dados, size_t total);
+
+// UART da rede RS-485 (rede.h), half-duplex com um transceptor: a recepção enche uma fila pela
+// interrupção, que também acorda o núcleo 0 de hal_dormir; o envio liga o transmissor (pino DE),
+// espera o último bit sair e o desliga, então bloqueia pelo tempo do quadro (~87 us por byte a 115200)
+void hal_uart_init(uint32_t baud, uint pino_tx, uint pino_rx, uint pino_de); // A taxa é reaplicada nas trocas de relógio
+bool hal_uart_pendente(void);
+size_t hal_uart_ler(uint8_t *dados, size_t max);
+void hal_uart_enviar(const uint8_t *dados, size_t total);
+
+#endif
@@ -0,0 +1,410 @@
+// Implementação da HAL (hal.h) para o RP2040, sobre o SDK do Pico
+#include <stdio.h>
+#include "hal.h"
+#include "hardware/sync.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/flash.h"
+#include "hardware/uart.h"
+#include "hardware/irq.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/sio.h"
+#include "hardware/structs/timer.h"
+#include "hardware/regs/m0plus.h"
+#include "pico/multicore.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "matriz.pio.h"
+#include "fluxo.pio.h"
+#include "sensores.h"
+
+#define PWM_CONTADOR_HZ 1000000 // Frequência do contador do PWM após o divisor (1 MHz)
+
+// Como time_us_64, mas na RAM: os alarmes que rodam durante a gravação da flash chamam esta
+uint64_t __not_in_flash_func(hal_tempo_us)(void) {
+  uint32_t alto, baixo;
+  do {
+    alto = timer_hw->timerawh;
+    baixo = timer_hw->timerawl;
+  } while (alto != timer_hw->timerawh); // A parte baixa voltou entre as leituras
+  return (uint64_t)alto << 32 | baixo;
+}
+
+void hal_dormir_ate(uint64_t prazo_us) {
+  best_effort_wfe_or_timeout(from_us_since_boot(prazo_us));
+}
+
+void hal_dormir(void) {
+  __wfe();
+}
+
+// SysTick de cada núcleo contando para baixo no clk_sys, sem interrupção; ligado no primeiro uso
+uint32_t hal_ciclos(void) {
+  if (!(systick_hw->csr & 1u)) {
+    systick_hw->rvr = 0xFFFFFFu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5u; // ENABLE | CLKSOURCE (clk_sys)
+  }
+  return ~systick_hw->cvr & 0xFFFFFFu;
+}
+
+uint32_t hal_ciclos_decorridos(uint32_t inicio) {
+  return (hal_ciclos() - inicio) & 0xFFFFFFu;
+}
+
+uint32_t hal_ciclos_por_us(void) {
+  return clock_get_hz(clk_sys) / 1000000;
+}
+
+void hal_barreira(void) {
+  __dmb();
+}
+
+void hal_sinalizar(void) {
+  __sev();
+}
+
+uint32_t hal_trava(void) {
+  return save_and_disable_interrupts();
+}
+
+void hal_destrava(uint32_t estado) {
+  restore_interrupts(estado);
+}
+
+void hal_gpio_saida(uint pino) {
+  gpio_init(pino);
+  gpio_set_dir(pino, GPIO_OUT);
+}
+
+void __not_in_flash_func(hal_gpio_put)(uint pino, bool valor) {
+  gpio_put(pino, valor);
+}
+
+bool hal_gpio_get(uint pino) {
+  return gpio_get(pino);
+}
+
+void hal_gpio_entrada(uint pino) {
+  gpio_init(pino);
+  gpio_set_dir(pino, GPIO_IN);
+  gpio_pull_up(pino);
+}
+
+hal_alarme_t hal_alarme_em_ms(uint32_t ms, hal_alarme_fn_t fn, void *ctx) {
+  return add_alarm_in_ms(ms, fn, ctx, true);
+}
+
+bool hal_alarme_cancelar(hal_alarme_t id) {
+  return cancel_alarm(id);
+}
+
+uint16_t hal_adc_ler(uint8_t canal) {
+  return sensores_ler(canal);
+}
+
+// I2C ------------------------------------------------------------------------------------------
+
+static int i2c_dma_chan[2] = {-1, -1};
+static uint32_t i2c_baud[2]; // 0 = não inicializado
+
+void hal_i2c_init(i2c_inst_t *i2c, uint32_t baud) {
+  i2c_baud[i2c_hw_index(i2c)] = baud;
+  i2c_init(i2c, baud);
+}
+
+// Prazo de uma transação: o fixo mais 9 bits por byte (com o de endereço) na taxa configurada
+static uint32_t i2c_prazo_us(i2c_inst_t *i2c, size_t total) {
+  uint32_t baud = i2c_baud[i2c_hw_index(i2c)];
+  return HAL_I2C_PRAZO_US + (baud ? (uint32_t)((total + 1) * 9000000ull / baud) : 0);
+}
+
+bool hal_i2c_escrever(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t total) {
+  return i2c_write_timeout_us(i2c, endereco, dados, total, false, i2c_prazo_us(i2c, total)) == (int)total;
+}
+
+// Leitura bloqueante de poucos bytes, como uma conversão do ADC das zonas
+bool hal_i2c_ler(i2c_inst_t *i2c, uint8_t endereco, uint8_t *dados, size_t total) {
+  return i2c_read_timeout_us(i2c, endereco, dados, total, false, i2c_prazo_us(i2c, total)) == (int)total;
+}
+
+// Palavras DATA_CMD copiadas pela DMA direto para o FIFO TX, no ritmo do DREQ do I2C
+void hal_i2c_dma(i2c_inst_t *i2c, uint8_t endereco, const uint16_t *palavras, size_t total) {
+  uint indice = i2c_hw_index(i2c);
+  if (i2c_dma_chan[indice] < 0) {
+    i2c_dma_chan[indice] = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(i2c_dma_chan[indice]);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(i2c_dma_chan[indice], &c, &i2c_get_hw(i2c)->data_cmd, palavras, 0, false);
+  }
+
+  // Mesmo procedimento de i2c_write_blocking para selecionar o endereço do dispositivo
+  i2c_hw_t *hw = i2c_get_hw(i2c);
+  hw->enable = 0;
+  hw->tar = endereco;
+  hw->enable = 1;
+
+  dma_channel_transfer_from_buffer_now(i2c_dma_chan[indice], palavras, total);
+}
+
+// Ainda há bytes sendo transferidos (DMA ativo, FIFO com dados ou barramento ocupado)
+bool hal_i2c_ocupado(i2c_inst_t *i2c) {
+  int chan = i2c_dma_chan[i2c_hw_index(i2c)];
+  if (chan >= 0 && dma_channel_is_busy(chan))
+    return true;
+  i2c_hw_t *hw = i2c_get_hw(i2c);
+  return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
+
+// Matriz de LEDs -------------------------------------------------------------------------------
+
+static int leds_dma_chan = -1;
+static int leds_sm = -1;
+
+void hal_leds_init(uint pino, uint8_t fitas) {
+  PIO pio = pio0;
+  uint sm = leds_sm = pio_claim_unused_sm(pio, true);
+  if (fitas > 1)
+    matriz_paralelo_program_init(pio, sm, pio_add_program(pio, &matriz_paralelo_program), pino, fitas);
+  else
+    matriz_program_init(pio, sm, pio_add_program(pio, &matriz_program), pino);
+
+  leds_dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(leds_dma_chan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+  dma_channel_configure(leds_dma_chan, &c, &pio->txf[sm], NULL, 0, false);
+}
+
+void hal_leds_enviar(const uint32_t *palavras, uint total) {
+  dma_channel_transfer_from_buffer_now(leds_dma_chan, palavras, total);
+}
+
+// DMA ativo ou palavras ainda no FIFO do PIO
+bool hal_leds_ocupado(void) {
+  return dma_channel_is_busy(leds_dma_chan) || !pio_sm_is_tx_fifo_empty(pio0, leds_sm);
+}
+
+// Sensor de vazão ------------------------------------------------------------------------------
+
+static int fluxo_sm = -1;
+
+void hal_fluxo_init(uint pino) {
+  PIO pio = pio1;
+  uint sm = fluxo_sm = pio_claim_unused_sm(pio, true);
+  fluxo_program_init(pio, sm, pio_add_program(pio, &fluxo_program), pino);
+}
+
+// O programa nunca dá push: o FIFO RX só recebe o valor pedido aqui, que chega no mesmo ciclo
+uint32_t hal_fluxo_pulsos(void) {
+  pio_sm_exec(pio1, fluxo_sm, pio_encode_mov_not(pio_isr, pio_x));
+  pio_sm_exec(pio1, fluxo_sm, pio_encode_push(false, false));
+  return pio_sm_get_blocking(pio1, fluxo_sm);
+}
+
+// PWM do buzzer --------------------------------------------------------------------------------
+
+static int pwm_pino = -1;
+
+// Divisor fixo: contador a 1 MHz, então wrap = 1 MHz / f - 1 cobre de ~16 Hz a alguns kHz
+void hal_pwm_init(uint pino) {
+  gpio_set_function(pino, GPIO_FUNC_PWM);
+  pwm_pino = pino;
+  uint slice = pwm_gpio_to_slice_num(pino);
+  pwm_config config = pwm_get_default_config();
+  pwm_config_set_clkdiv_int(&config, clock_get_hz(clk_sys) / PWM_CONTADOR_HZ);
+  pwm_init(slice, &config, false);
+  pwm_set_gpio_level(pino, 0);
+}
+
+// Só escreve wrap, nível (50% de ciclo ativo) e o bit de habilitação do slice
+void __not_in_flash_func(hal_pwm_tom)(uint pino, uint16_t freq_hz) {
+  uint slice = pwm_gpio_to_slice_num(pino);
+  if (!freq_hz) {
+    pwm_set_gpio_level(pino, 0);
+    pwm_set_enabled(slice, false);
+    return;
+  }
+  uint32_t wrap = PWM_CONTADOR_HZ / freq_hz - 1;
+  pwm_set_wrap(slice, wrap);
+  pwm_set_gpio_level(pino, (wrap + 1) / 2);
+  pwm_set_enabled(slice, true);
+}
+
+// UART da rede --------------------------------------------------------------------------------
+
+// Sempre o uart1: TX nos GPIO 4, 8 ou 20 e RX nos GPIO 5, 9 ou 21. O uart0 divide os GPIO 0/1 com o
+// ADC I2C das zonas. Fila de recepção escrita só pela interrupção e lida só pelo núcleo 0.
+#define UART_FILA 256 // Potência de 2: alguns quadros da rede
+static uint8_t uart_fila[UART_FILA];
+static volatile uint32_t uart_cabeca; // Escrito apenas pela interrupção
+static volatile uint32_t uart_cauda; // Escrito apenas pelo núcleo 0
+static uint32_t uart_baud; // 0 = não inicializada
+static uint uart_de;
+
+// Esvazia o FIFO de hardware; com a fila cheia os bytes são perdidos e o CRC do quadro acusa
+static void uart_recebe(void) {
+  while (uart_is_readable(uart1)) {
+    uint8_t b = uart_getc(uart1);
+    uint32_t c = uart_cabeca;
+    if (c - uart_cauda < UART_FILA) {
+      uart_fila[c & (UART_FILA - 1)] = b;
+      __dmb();
+      uart_cabeca = c + 1;
+    }
+  }
+}
+
+void hal_uart_init(uint32_t baud, uint pino_tx, uint pino_rx, uint pino_de) {
+  uart_baud = baud;
+  uart_init(uart1, baud);
+  gpio_set_function(pino_tx, GPIO_FUNC_UART);
+  gpio_set_function(pino_rx, GPIO_FUNC_UART);
+  uart_de = pino_de;
+  hal_gpio_saida(pino_de); // Transmissor desligado: o barramento é de quem o coordenador consultar
+  irq_set_exclusive_handler(UART1_IRQ, uart_recebe);
+  irq_set_enabled(UART1_IRQ, true);
+  uart_set_irq_enables(uart1, true, false); // FIFO com dados ou linha parada após o último byte
+}
+
+bool hal_uart_pendente(void) {
+  return uart_cabeca != uart_cauda;
+}
+
+size_t hal_uart_ler(uint8_t *dados, size_t max) {
+  uint32_t c = uart_cauda, fim = uart_cabeca;
+  __dmb();
+  size_t n = 0;
+  for (; c != fim && n < max; ++c)
+    dados[n++] = uart_fila[c & (UART_FILA - 1)];
+  uart_cauda = c;
+  return n;
+}
+
+// Com /RE ligado ao DE no transceptor, a própria transmissão não volta pela recepção
+void hal_uart_enviar(const uint8_t *dados, size_t total) {
+  gpio_put(uart_de, true);
+  uart_write_blocking(uart1, dados, total);
+  uart_tx_wait_blocking(uart1); // Até o bit de parada do último byte sair do registrador de deslocamento
+  gpio_put(uart_de, false);
+}
+
+// Relógio --------------------------------------------------------------------------------------
+
+#ifndef SYS_CLK_KHZ
+#define SYS_CLK_KHZ 125000
+#endif
+
+void hal_relogio_economia(bool economia) {
+  if (economia)
+    set_sys_clock_48mhz();
+  else
+    set_sys_clock_khz(SYS_CLK_KHZ, true);
+
+  // O temporizador (alarmes, agenda) e o ADC não dependem do clk_sys; os demais são reajustados. O
+  // I2C do display e o PIO da matriz são do núcleo 1, parado pelo chamador sem envios em andamento.
+  uint32_t hz = clock_get_hz(clk_sys);
+  i2c_inst_t *const i2c[2] = {i2c0, i2c1};
+  for (uint i = 0; i < 2; ++i)
+    if (i2c_baud[i])
+      i2c_set_baudrate(i2c[i], i2c_baud[i]);
+  if (pwm_pino >= 0)
+    pwm_set_clkdiv_int_frac(pwm_gpio_to_slice_num(pwm_pino), hz / PWM_CONTADOR_HZ, 0);
+  if (leds_sm >= 0)
+    pio_sm_set_clkdiv(pio0, leds_sm, hz / 8000000.0f); // Mesmos 8 MHz de matriz_program_init e matriz_paralelo_program_init
+  if (fluxo_sm >= 0)
+    pio_sm_set_clkdiv(pio1, fluxo_sm, hz / 1000000.0f); // 1 MHz de fluxo_program_init: o filtro de ruído fica em 32 us
+  if (uart_baud)
+    uart_set_baudrate(uart1, uart_baud); // clk_peri vem do clk_sys
+}
+
+// Flash ----------------------------------------------------------------------------------------
+
+// Enquanto a flash está fora do modo XIP o núcleo 0 não pode buscar instruções nela. Em vez do
+// flash_safe_execute do SDK, que o pausa com as interrupções desligadas (o alarme que desliga o relé
+// esperaria o apagamento inteiro), o núcleo 1 o chama pelo FIFO entre os núcleos: a interrupção do
+// FIFO, na menor prioridade, espera na RAM com só a interrupção do alarm pool habilitada no NVIC,
+// e os alarmes a interrompem normalmente.
+#define FLASH_ALARMES_IRQ (TIMER_IRQ_0 + PICO_TIME_DEFAULT_ALARM_POOL_HARDWARE_ALARM_NUM)
+#define NVIC_ISER ((io_rw_32 *)(PPB_BASE + M0PLUS_NVIC_ISER_OFFSET))
+#define NVIC_ICER ((io_rw_32 *)(PPB_BASE + M0PLUS_NVIC_ICER_OFFSET))
+
+static volatile bool flash_ocupada; // Escrito apenas pelo núcleo 1
+static volatile bool nucleo0_parado; // Escrito apenas pelo núcleo 0
+
+static void __not_in_flash_func(nucleo0_espera)(void) {
+  while (sio_hw->fifo_st & SIO_FIFO_ST_VLD_BITS)
+    (void)sio_hw->fifo_rd;
+  uint32_t habilitadas = *NVIC_ISER;
+  *NVIC_ICER = habilitadas & ~(1u << FLASH_ALARMES_IRQ);
+  nucleo0_parado = true;
+  __sev();
+  while (flash_ocupada)
+    __wfe(); // Acordado pelos alarmes e pelo __sev do fim da gravação
+  *NVIC_ISER = habilitadas; // O que chegou durante a gravação ficou pendente e é atendido agora
+  nucleo0_parado = false;
+}
+
+void hal_flash_pausavel(void) {
+  irq_set_exclusive_handler(SIO_IRQ_PROC0, nucleo0_espera);
+  irq_set_priority(SIO_IRQ_PROC0, PICO_LOWEST_IRQ_PRIORITY);
+  irq_set_enabled(SIO_IRQ_PROC0, true);
+}
+
+// No núcleo 1: para o núcleo 0 na RAM e executa a operação com as próprias interrupções desligadas
+static void flash_executar(uint32_t deslocamento, const uint8_t *pagina) {
+  while (nucleo0_parado) // A gravação anterior ainda não foi liberada pelo núcleo 0
+    tight_loop_contents();
+  flash_ocupada = true;
+  __dmb();
+  multicore_fifo_push_blocking(0);
+  while (!nucleo0_parado)
+    tight_loop_contents();
+  uint32_t estado = save_and_disable_interrupts();
+  if (pagina)
+    flash_range_program(deslocamento, pagina, FLASH_PAGE_SIZE);
+  else
+    flash_range_erase(deslocamento, FLASH_SECTOR_SIZE);
+  restore_interrupts(estado);
+  flash_ocupada = false;
+  __dmb();
+  __sev();
+}
+
+void hal_flash_apagar(uint32_t deslocamento) {
+  flash_executar(deslocamento, NULL);
+}
+
+void hal_flash_programar(uint32_t deslocamento, const uint8_t *pagina) {
+  flash_executar(deslocamento, pagina);
+}
+
+const uint8_t *hal_flash_ler(uint32_t deslocamento) {
+  return (const uint8_t *)(uintptr_t)(XIP_BASE + deslocamento);
+}
+
+// Serial ---------------------------------------------------------------------------------------
+
+int hal_serial_ler(void) {
+  int c = getchar_timeout_us(0);
+  return c < 0 ? -1 : c;
+}
+
+// Espaço no FIFO de saída do CDC: escrever até isso não espera o host. Sem host conectado o
+// stdio da USB descarta a saída, então nada é oferecido.
+size_t hal_serial_livre(void) {
+  return stdio_usb_connected() ? tud_cdc_write_available() : 0;
+}
+
+void hal_serial_escrever_bruto(const uint8_t *dados, size_t total) {
+  fflush(stdout); // Texto pendente sai antes dos bytes binários
+  for (size_t i = 0; i < total; ++i)
+    putchar_raw(dados[i]);
+}
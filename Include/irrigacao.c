@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include "irrigacao.h"
+#include "fixo.h"
+
+void irrigacao_init(irrigacao_t *irr, const uint8_t *pinos_rele, uint8_t zonas) {
+  *irr = (irrigacao_t){
+    .zonas = zonas > ZONAS_MAX ? ZONAS_MAX : zonas,
+    .histerese_q8 = PCT_Q8(5),
+    .absorcao_ms = 30000,
+    .desligado_min_ms = 10000,
+    .janela_ms = 3600000,
+    .ciclo_max_pct = 10,
+    .intervalo_zonas_ms = 2000,
+    .ligada = -1,
+  };
+  uint64_t agora = hal_tempo_us();
+  for (uint8_t z = 0; z < irr->zonas; ++z) {
+    irr->pino_rele[z] = pinos_rele[z];
+    irr->estado[z] = REGA_OCIOSA;
+    irr->janela_inicio_us[z] = agora;
+    hal_gpio_saida(pinos_rele[z]);
+    hal_gpio_put(pinos_rele[z], false);
+  }
+}
+
+// Desliga o relé ligado e contabiliza o tempo. Chamada pelo alarme (interrupção) ou pelo controle.
+// Na RAM, como o alarme: o relé desliga no horário mesmo durante uma gravação da flash.
+static void __not_in_flash_func(desligar)(irrigacao_t *irr) {
+  int8_t z = irr->ligada;
+  if (z < 0)
+    return;
+  hal_gpio_put(irr->pino_rele[z], false);
+  irr->ligada = -1;
+  uint64_t agora = hal_tempo_us();
+  irr->fim_us[z] = irr->liberado_us = agora;
+  irr->bomba_total_us[z] += agora - irr->inicio_us;
+  irr->bomba_janela_us[z] += agora - irr->inicio_us;
+}
+
+static int64_t __not_in_flash_func(alarme_desliga)(hal_alarme_t id, void *user_data) {
+  irrigacao_t *irr = user_data;
+  desligar(irr);
+  irr->alarme = 0;
+  return 0;
+}
+
+static bool pode_ligar(irrigacao_t *irr, uint8_t z, uint64_t agora, uint8_t tempo_rega_s) {
+  if (agora - irr->janela_inicio_us[z] >= irr->janela_ms * 1000ull) {
+    irr->janela_inicio_us[z] = agora;
+    irr->bomba_janela_us[z] = 0;
+  }
+  if (irr->regas[z] && agora - irr->fim_us[z] < irr->desligado_min_ms * 1000ull)
+    return false;
+  uint64_t limite_us = irr->janela_ms * 10ull * irr->ciclo_max_pct;
+  return irr->bomba_janela_us[z] + tempo_rega_s * 1000000ull <= limite_us;
+}
+
+static bool ligar(irrigacao_t *irr, uint8_t z, uint64_t agora, uint8_t tempo_rega_s) {
+  irr->inicio_us = agora;
+  irr->ligada = z;
+  hal_gpio_put(irr->pino_rele[z], true);
+
+  // Um único alarme por rega: nunca há mais de um pendente para o suprimento
+  hal_alarme_t id = hal_alarme_em_ms(tempo_rega_s * 1000u, alarme_desliga, irr);
+  ++irr->alarmes_criados;
+  if (id > 0) {
+    irr->alarme = id;
+  } else if (id < 0) {
+    // Sem alarmes livres: não deixa o relé ligado sem garantia de desligamento
+    ++irr->alarmes_falhos;
+    desligar(irr);
+    return false;
+  } // id == 0: já disparou dentro de hal_alarme_em_ms
+  irr->estado[z] = REGA_IRRIGANDO;
+  irr->sede[z] = irr->aguardando[z] = false;
+  ++irr->regas[z];
+  return true;
+}
+
+// Um passo da máquina de estados de uma zona; marca a sede, mas não liga o relé
+static void avancar(irrigacao_t *irr, uint8_t z, uint16_t umidade_q8, int8_t ideal, uint64_t agora) {
+  int32_t limiar = PCT_Q8(ideal - 20);
+  bool lida = umidade_q8 != ZONA_SEM_LEITURA;
+
+  switch (irr->estado[z]) {
+  case REGA_OCIOSA:
+    irr->sede[z] = lida && umidade_q8 < limiar;
+    break;
+
+  case REGA_IRRIGANDO:
+    if (lida && umidade_q8 > PCT_Q8(ideal + 20) && irr->ligada == z)
+      irrigacao_abortar(irr); // Solo já encharcado: não espera o fim do tempo de rega
+    if (irr->ligada != z)
+      irr->estado[z] = REGA_ABSORCAO;
+    break;
+
+  case REGA_ABSORCAO:
+    if (agora - irr->fim_us[z] >= irr->absorcao_ms * 1000ull)
+      irr->estado[z] = REGA_REMEDICAO;
+    break;
+
+  case REGA_REMEDICAO:
+    if (!lida || umidade_q8 >= limiar + irr->histerese_q8) {
+      irr->estado[z] = REGA_OCIOSA;
+      irr->sede[z] = false;
+    } else {
+      irr->sede[z] = true;
+    }
+    break;
+  }
+  irr->aguardando[z] = irr->sede[z];
+}
+
+// Tempo limitado: um passo por zona e no máximo uma rega iniciada por chamada
+int8_t irrigacao_atualizar(irrigacao_t *irr, const uint16_t *umidade_q8, const volatile int8_t *ideal,
+                           const volatile int8_t *tempo_rega_s) {
+  uint64_t agora = hal_tempo_us();
+  for (uint8_t z = 0; z < irr->zonas; ++z)
+    avancar(irr, z, umidade_q8[z], ideal[z], agora);
+
+  if (irr->ligada >= 0 || irr->sem_agua || irr->sem_vez || agora - irr->liberado_us < irr->intervalo_zonas_ms * 1000ull)
+    return -1; // Suprimento ocupado, sem água, sem a vez ou se recuperando: as zonas com sede ficam aguardando
+  for (uint8_t i = 0; i < irr->zonas; ++i) {
+    uint8_t z = (irr->proxima + i) % irr->zonas;
+    if (!irr->sede[z] || !pode_ligar(irr, z, agora, tempo_rega_s[z]))
+      continue;
+    if (!ligar(irr, z, agora, tempo_rega_s[z]))
+      return -1;
+    irr->proxima = (z + 1) % irr->zonas;
+    return z;
+  }
+  return -1;
+}
+
+// Corta o relé imediatamente (bomba a seco, reservatório baixo, solo encharcado) e libera o alarme
+void irrigacao_abortar(irrigacao_t *irr) {
+  if (irr->alarme > 0 && hal_alarme_cancelar(irr->alarme))
+    ++irr->alarmes_cancelados;
+  uint32_t status = hal_trava();
+  int8_t z = irr->ligada;
+  irr->alarme = 0;
+  desligar(irr);
+  hal_destrava(status);
+  if (z >= 0 && irr->estado[z] == REGA_IRRIGANDO)
+    irr->estado[z] = REGA_ABSORCAO;
+}
+
+bool irrigacao_ocupada(const irrigacao_t *irr) {
+  for (uint8_t z = 0; z < irr->zonas; ++z)
+    if (irr->estado[z] != REGA_OCIOSA)
+      return true;
+  return false;
+}
+
+uint32_t irrigacao_regas(const irrigacao_t *irr) {
+  uint32_t total = 0;
+  for (uint8_t z = 0; z < irr->zonas; ++z)
+    total += irr->regas[z];
+  return total;
+}
+
+uint64_t irrigacao_bomba_total_us(const irrigacao_t *irr) {
+  uint64_t total = 0;
+  for (uint8_t z = 0; z < irr->zonas; ++z)
+    total += irr->bomba_total_us[z];
+  return total;
+}
+
+void irrigacao_relatorio(const irrigacao_t *irr) {
+  printf("Regas: %lu, bomba ligada: %lu s, alarmes: %lu criados, %lu cancelados, %lu falhos\n",
+         (unsigned long)irrigacao_regas(irr), (unsigned long)(irrigacao_bomba_total_us(irr) / 1000000),
+         (unsigned long)irr->alarmes_criados, (unsigned long)irr->alarmes_cancelados,
+         (unsigned long)irr->alarmes_falhos);
+  for (uint8_t z = 0; z < irr->zonas; ++z)
+    printf("  zona %u: %lu regas, %lu s ligada (janela: %lu s)\n", z + 1, (unsigned long)irr->regas[z],
+           (unsigned long)(irr->bomba_total_us[z] / 1000000), (unsigned long)(irr->bomba_janela_us[z] / 1000000));
+}
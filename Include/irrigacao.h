@@ -0,0 +1,70 @@
+#ifndef IRRIGACAO_H
+#define IRRIGACAO_H
+
+#include "hal.h"
+#include "zonas.h"
+
+// Máquina de estados da irrigação, uma por zona: ociosa -> irrigando -> absorção -> remedição ->
+// (ociosa | irrigando). A rega só começa abaixo de (ideal - 20)% e o ciclo só termina quando a
+// umidade passa de (ideal - 20)% + histerese.
+//
+// As zonas dividem o mesmo suprimento de água: no máximo um relé ligado por vez, com um intervalo
+// entre o fim de uma rega e o início da próxima. Zonas com sede esperam na fila e são atendidas em
+// rodízio a partir da última regada. Assim basta um único alarme de hardware, reutilizado a cada
+// rega, para desligar o relé no tempo exato mesmo que o laço de controle atrase.
+//
+// O estado fica em estrutura de arrays (um array por campo, indexado pela zona): a varredura de
+// todas as zonas a cada período percorre só os campos que usa.
+
+typedef enum {
+  REGA_OCIOSA,
+  REGA_IRRIGANDO,
+  REGA_ABSORCAO,
+  REGA_REMEDICAO
+} rega_estado_t;
+
+typedef struct {
+  // Configuração comum
+  uint8_t zonas;
+  uint16_t histerese_q8; // Banda acima do limiar de início para encerrar o ciclo (% em Q8.8)
+  uint32_t absorcao_ms; // Espera após cada rega para a água se espalhar antes de medir de novo
+  uint32_t desligado_min_ms; // Tempo mínimo de uma zona desligada entre duas regas dela
+  uint32_t janela_ms; // Janela para o limite de ciclo ativo de cada zona
+  uint8_t ciclo_max_pct; // Máximo de tempo ligado dentro da janela (%)
+  uint32_t intervalo_zonas_ms; // Pausa do suprimento entre regas consecutivas (de zonas quaisquer)
+
+  // Por zona
+  uint8_t pino_rele[ZONAS_MAX];
+  uint8_t estado[ZONAS_MAX]; // rega_estado_t
+  bool sede[ZONAS_MAX]; // Precisa de rega (ociosa abaixo do limiar ou remedição sem atingir a banda)
+  bool aguardando[ZONAS_MAX]; // Com sede, mas bloqueada pelo suprimento, pelo tempo mínimo ou pelo ciclo ativo
+  volatile uint64_t fim_us[ZONAS_MAX]; // Última vez que o relé da zona desligou
+  uint64_t janela_inicio_us[ZONAS_MAX];
+  volatile uint64_t bomba_total_us[ZONAS_MAX]; // Tempo total com o relé ligado
+  volatile uint64_t bomba_janela_us[ZONAS_MAX]; // Tempo ligado na janela atual
+  uint32_t regas[ZONAS_MAX];
+
+  // Suprimento compartilhado
+  volatile int8_t ligada; // Zona com o relé ligado (-1 = nenhuma)
+  volatile hal_alarme_t alarme;
+  uint64_t inicio_us; // Início da rega em andamento
+  volatile uint64_t liberado_us; // Fim da última rega (qualquer zona)
+  bool sem_agua; // Reservatório baixo ou bomba a seco (agua.h): as zonas com sede ficam aguardando
+  bool sem_vez; // Em rede, sem a vez da bomba dada pelo coordenador (rede.h): idem
+  uint8_t proxima; // Início do rodízio na próxima busca por zona com sede
+  uint32_t alarmes_criados, alarmes_cancelados, alarmes_falhos;
+} irrigacao_t;
+
+void irrigacao_init(irrigacao_t *irr, const uint8_t *pinos_rele, uint8_t zonas);
+
+// Avança as máquinas de estados de todas as zonas com a umidade atual (Q8.8 ou ZONA_SEM_LEITURA) e
+// liga no máximo uma zona. Retorna a zona que acabou de começar a rega ou -1.
+int8_t irrigacao_atualizar(irrigacao_t *irr, const uint16_t *umidade_q8, const volatile int8_t *ideal,
+                           const volatile int8_t *tempo_rega_s);
+void irrigacao_abortar(irrigacao_t *irr); // Corta a rega em andamento
+bool irrigacao_ocupada(const irrigacao_t *irr); // Alguma zona fora do estado ocioso
+uint32_t irrigacao_regas(const irrigacao_t *irr); // Total de todas as zonas
+uint64_t irrigacao_bomba_total_us(const irrigacao_t *irr);
+void irrigacao_relatorio(const irrigacao_t *irr);
+
+#endif
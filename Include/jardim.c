@@ -0,0 +1,891 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jardim.h"
+#include "matriz_leds.h"
+#include "fixo.h"
+#include "agenda.h"
+#include "estado.h"
+#include "buzzer.h"
+#include "registro.h"
+#include "energia.h"
+#include "perfil.h"
+#include "telemetria.h"
+#include "zonas.h"
+#include "painel.h"
+#include "ajustes.h"
+#include "botoes.h"
+#include "agua.h"
+#include "grafico.h"
+#include "estatistica.h"
+#include "rede.h"
+
+// Variáveis de controle com botões, por zona (iniciadas pela tabela de zonas)
+volatile int8_t ideal[ZONAS_MAX]; // Valor ideal de umidade do solo
+volatile int8_t tempo_rega[ZONAS_MAX]; // Tempo de rega
+volatile uint8_t zona_exibida; // Zona da página atual do display, ajustada pelos botões
+static uint8_t grafico_exibido; // Escala do gráfico na tela mais 1 (0 = tela de valores), escolhida pelos botões
+
+// Variáveis de controle do alerta
+#define Alerta_ms 3000  // Tempo do alerta (ms)
+static volatile bool evento = false;  // Estado do evento para acionamento do buzzer
+irrigacao_t rega; // Estado da irrigação e contabilidade da bomba
+static alerta_t alerta = ALERTA_NENHUM; // Fase do alerta, publicada para a telemetria do núcleo 1
+static const nota_t melodia_alerta[] = {{250, 250}, {400, 250}}; // Alterna 250 Hz e 400 Hz a cada 250 ms
+
+// Variáveis de controle da conversão ADC
+static uint16_t adc_value_luz; // Valor lido do sensor de luminosidade
+static uint16_t adc_umidade[ZONAS_MAX]; // Leituras de umidade do solo por zona (ver zonas.h)
+static uint16_t umidade[ZONAS_MAX]; // Umidade do solo em %, formato Q8.8 (ver fixo.h), ou ZONA_SEM_LEITURA
+static uint8_t zonas; // Total de zonas da tabela
+static uint8_t intensidade = 128; // Intensidade da matriz de LEDs (0-255), varia de acordo com a luminosidade do ambiente
+
+// Estatística das leituras brutas (ver estatistica.h): defeitos dos sensores e cadência do controle
+#define FALHA_LUZ (1u << ZONAS_MAX)
+#define INCLINACAO_ESTAVEL_Q8 (JARDIM_ESTAVEL_PCT_H * 4095 * 256 / 100) // %/h em contagens/h, Q8
+static estat_t estat_luz, estat_umidade[ZONAS_MAX];
+static uint16_t falhas; // Sensores com defeito, bits como em estado_t
+static uint32_t periodo_ms = 100; // Período aplicado às tarefas de sensores, rega e publicação
+
+// Nó da rede RS-485 (rede.h): as regas esperam a vez dada pelo coordenador
+static rede_no_t rede_no;
+static bool rede_ativa;
+
+// Coordenador da rede (rede.h), quando esta placa é o coordenador: consultas pela tarefa "rede" e
+// respostas pela interrupção da UART, no núcleo 0. Os ajustes pedidos pela serial vêm do núcleo 1 por
+// uma fila de um produtor e um consumidor.
+#define PEDIDOS_AJUSTE 8
+static rede_coord_t rede_coord;
+static bool rede_coordenando;
+static struct {
+  uint8_t endereco, zona, ideal, rega;
+} pedidos_ajuste[PEDIDOS_AJUSTE];
+static volatile uint32_t pedidos_cabeca, pedidos_cauda; // Cabeça escrita pelo núcleo 1, cauda pelo núcleo 0
+static char comando_ajuste[24]; // Comando "A" da serial em andamento (núcleo 1)
+static uint8_t comando_total; // 0 = fora de um comando
+static uint64_t comando_us; // Último caractere do comando
+
+static tela_t tela = TELA_LIGADA; // Estado da tela decidido pela gerência de energia
+
+// Troca do relógio combinada entre os núcleos: o I2C do display e o PIO da matriz, do núcleo 1, são
+// reajustados pela troca, então o núcleo 0 pede, o núcleo 1 termina os envios em andamento e fica
+// parado, e só então o núcleo 0 troca o relógio e o libera
+static volatile bool relogio_pedido; // Escrito só pelo núcleo 0
+static volatile uint32_t relogio_troca; // Número do pedido (núcleo 0)
+static volatile uint32_t interface_parada; // Número do pedido atendido (núcleo 1): um aviso antigo não vale para o seguinte
+static energia_modo_t relogio_modo; // Modo pedido
+
+static ssd1306_t *ssd; // Display usado pelo núcleo 1
+static painel_t painel; // Rótulos e borda compostos uma vez; só os campos abaixo são redesenhados
+static int8_t campo_zona, campo_luz, campo_umid, campo_ideal, campo_rega, campo_msg;
+
+// Definição de strings para exibição no display
+static char str_zona[13] = "Zona ", str_luz[7], str_umid[7], str_ideal[5], str_rega[4];
+
+// Gráfico no buffer do display (núcleo 1): escala mais 1 (0 = painel de valores), zona e colunas já desenhadas
+static uint8_t grafico_na_tela, grafico_zona;
+static uint32_t grafico_desenhadas;
+
+// Tarefas do escalonador (ver agenda.h), todas no núcleo 0
+static int tarefa_agua, tarefa_fim_alerta, tarefa_botoes, tarefa_rede;
+static int tarefas_periodicas[4]; // sensores, rega, publica e energia: período trocado entre os modos de energia
+
+// Tempo de boot, desde o reset (o timer do RP2040 parte de zero): fim de jardim_init e primeira decisão de rega
+static uint64_t boot_init_us, boot_decisao_us;
+
+// Etapas medidas com perfil.h (sensores no núcleo 0, as demais no núcleo 1)
+PERFIL_ETAPA(perfil_sensores, "sensores");
+PERFIL_ETAPA(perfil_formata, "formata");
+PERFIL_ETAPA(perfil_texto, "texto");
+PERFIL_ETAPA(perfil_envio, "envio");
+PERFIL_ETAPA(perfil_leds, "leds");
+PERFIL_ETAPA(perfil_telemetria, "telemetria");
+PERFIL_ETAPA(perfil_historico, "historico");
+
+// Fim do alerta: encerra o evento (a bomba já foi cortada quando ele começou)
+static void fim_alerta(void *ctx) {
+  buzzer_parar();
+  evento = false; // Reseta o evento
+  alerta = ALERTA_DESLIGADO;
+}
+
+// Alerta de falta de água: toca a melodia em segundo plano por Alerta_ms
+static void dispara_alerta(void) {
+  evento = true;
+  alerta = ALERTA_TOCANDO;
+  buzzer_tocar(melodia_alerta, count_of(melodia_alerta), Alerta_ms / 500); // Ciclos de 500 ms, tocados em segundo plano
+  agenda_em(tarefa_fim_alerta, Alerta_ms);
+}
+
+// Conferência da vazão com a bomba ligada (agua.h): AGUA_PARTIDA_MS depois da partida e então a
+// cada AGUA_JANELA_MS. Sem vazão ou com a boia baixa, corta a rega na hora e toca o alerta.
+static void confere_agua(void *ctx) {
+  if (rega.ligada != agua_zona()) {
+    agua_fim(); // A rega terminou (alarme do relé ou solo encharcado): contabiliza a água
+    return;
+  }
+  if (agua_conferir() && !agua_reservatorio_baixo()) {
+    if (alerta == ALERTA_VERIFICANDO)
+      alerta = ALERTA_CANCELADO; // Água chegando: sem alerta nesta rega
+    agenda_em(tarefa_agua, AGUA_JANELA_MS);
+    return;
+  }
+  irrigacao_abortar(&rega);
+  agua_fim();
+  rega.sem_agua = true;
+  dispara_alerta();
+}
+
+// Estatística de cada leitura bruta: um sensor no trilho ou preso passa a valer como sem leitura
+// (a zona nunca é regada por ele) e cada defeito novo toca o alerta
+static void confere_sensores(void) {
+  uint64_t agora = hal_tempo_us();
+  uint16_t atuais = 0;
+  estat_amostra(&estat_luz, adc_value_luz, agora);
+  if (estat_luz.falha)
+    atuais |= FALHA_LUZ;
+  for (uint8_t z = 0; z < zonas; ++z) {
+    if (adc_umidade[z] != ZONA_SEM_LEITURA) // ADC I2C sem resposta já é tratado pela varredura
+      estat_amostra(&estat_umidade[z], adc_umidade[z], agora);
+    if (estat_umidade[z].falha)
+      atuais |= 1u << z;
+  }
+  if ((atuais & ~falhas) && !evento) {
+    dispara_alerta();
+    alerta = ALERTA_SENSOR;
+  }
+  falhas = atuais;
+}
+
+// Leitura dos sensores: luminosidade e varredura das zonas (valores já filtrados pela aquisição contínua)
+static void tarefa_sensores(void *ctx) {
+  PERFIL_INICIO(perfil_sensores);
+  adc_value_luz = hal_adc_ler(SENSOR_CANAL_LUZ); // Última leitura filtrada de luminosidade (pino 26)
+  zonas_varrer(adc_umidade); // Diretas todas; multiplexador e ADC I2C uma zona por chamada
+  confere_sensores();
+  // Ajusta a intensidade da matriz de LEDs de acordo com o valor de luminosidade (meia intensidade com o LDR com defeito)
+  intensidade = falhas & FALHA_LUZ ? 128 : 255 - adc_para_nivel(adc_value_luz);
+  for (uint8_t z = 0; z < zonas; ++z) // Converte as leituras em % (Q8.8)
+    umidade[z] = adc_umidade[z] == ZONA_SEM_LEITURA || (falhas & (1u << z)) ? ZONA_SEM_LEITURA : adc_para_pct_q8(adc_umidade[z]);
+  PERFIL_FIM(perfil_sensores);
+  energia_amostra();
+}
+
+// Acionamento dos relés de acordo com a umidade do solo de cada zona, uma zona por vez
+static void tarefa_rega(void *ctx) {
+  bool sem_agua = agua_bloqueada();
+  if (sem_agua && !rega.sem_agua && !evento)
+    dispara_alerta(); // O reservatório acabou de baixar
+  rega.sem_agua = sem_agua;
+  rega.sem_vez = rede_ativa && !rede_no_liberado(&rede_no, hal_tempo_us());
+  int8_t z = irrigacao_atualizar(&rega, umidade, ideal, tempo_rega);
+  if (!boot_decisao_us) {
+    for (uint8_t i = 0; i < zonas; ++i)
+      if (umidade[i] != ZONA_SEM_LEITURA)
+        boot_decisao_us = hal_tempo_us(); // Primeira decisão com leitura e com os ajustes já carregados
+  }
+  if (z >= 0) {
+    // Zona acabou de ligar: mede a água entregue e confere se ela está chegando
+    agua_fim();
+    agua_inicio(z);
+    if (!evento)
+      alerta = ALERTA_VERIFICANDO;
+    agenda_em(tarefa_agua, AGUA_PARTIDA_MS);
+  }
+}
+
+// Mensagem de estado da irrigação de uma zona, exibida no display
+static const char *mensagem_rega(uint8_t z) {
+  if (falhas & (1u << z))
+    return "Sensor falhou!";
+  if (umidade[z] == ZONA_SEM_LEITURA)
+    return "Sem leitura!";
+  if (rega.estado[z] == REGA_IRRIGANDO)
+    return "Irrigando...";
+  if (rega.estado[z] != REGA_OCIOSA)
+    return "Absorvendo..."; // Aguardando a água se espalhar para medir de novo
+  if (rega.aguardando[z] && rega.sem_agua)
+    return "Sem agua!"; // Reservatório baixo ou bomba a seco
+  if (rega.aguardando[z] && rega.sem_vez)
+    return "Aguardando vez"; // Outra placa da rede com a bomba
+  if (rega.aguardando[z])
+    return "Aguardando..."; // Outra zona regando, tempo mínimo desligado ou limite de ciclo
+  if (umidade[z] > PCT_Q8(ideal[z] - 20) && umidade[z] < PCT_Q8(ideal[z] + 20))
+    return "Rega em breve!";
+  if (umidade[z] > PCT_Q8(ideal[z] + 20))
+    return "Solo umido!";
+  return "";
+}
+
+// Página do display: avança de zona a cada JARDIM_PAGINA_MS, parada enquanto os botões estão em uso
+static void avanca_pagina(void) {
+  static uint64_t proxima;
+  uint64_t agora = hal_tempo_us();
+  if (zonas < 2 || grafico_exibido || agora - energia_ultima_atividade_us() < JARDIM_PAGINA_PAUSA_MS * 1000ull) {
+    proxima = agora + JARDIM_PAGINA_MS * 1000ull;
+    return;
+  }
+  if (agora >= proxima) {
+    zona_exibida = (zona_exibida + 1) % zonas;
+    proxima = agora + JARDIM_PAGINA_MS * 1000ull;
+  }
+}
+
+// Publica o retrato do estado para o núcleo 1; nunca bloqueia o controle
+static void tarefa_publica(void *ctx) {
+  static uint32_t sequencia;
+  avanca_pagina();
+  uint8_t z = zona_exibida < zonas ? zona_exibida : 0;
+  estado_t e = {
+    .sequencia = ++sequencia,
+    .adc_luz = adc_value_luz,
+    .intensidade = intensidade,
+    .zonas = zonas,
+    .zona = z,
+    .irrigando = rega.ligada,
+    .alerta = alerta,
+    .msg_rega = mensagem_rega(z),
+    .tela = tela,
+    .falhas = falhas,
+    .grafico = grafico_exibido,
+  };
+  for (uint8_t i = 0; i < zonas; ++i) {
+    e.adc_umidade[i] = adc_umidade[i];
+    e.umidade[i] = umidade[i];
+    e.ideal[i] = ideal[i];
+    e.tempo_rega[i] = tempo_rega[i];
+  }
+  estado_publicar(&e);
+}
+
+// Período de sensores, rega e publicação. Fora da economia (botões, rega, alerta) fica em 100 ms.
+// Em economia parte de ENERGIA_PERIODO_ECONOMIA_MS: com a umidade de todas as zonas parada as
+// leituras se espaçam até JARDIM_PERIODO_ESTAVEL_MS, e uma zona que deve chegar ao limiar de rega
+// em menos de JARDIM_HORIZONTE_S passa a ser lida a cada JARDIM_PERIODO_TENDENCIA_MS.
+static uint32_t periodo_controle(void) {
+  if (energia_modo_atual() != ENERGIA_ECONOMIA)
+    return 100;
+  bool estavel = true;
+  for (uint8_t z = 0; z < zonas; ++z) {
+    if (umidade[z] == ZONA_SEM_LEITURA)
+      continue;
+    const estat_t *s = &estat_umidade[z];
+    int32_t t = estat_tempo_ate(s, pct_para_adc(ideal[z] > 20 ? ideal[z] - 20 : 0));
+    if (t >= 0 && t < JARDIM_HORIZONTE_S)
+      return JARDIM_PERIODO_TENDENCIA_MS;
+    estavel = estavel && estat_estavel(s, JARDIM_ESTAVEL_DESVIO << 8, INCLINACAO_ESTAVEL_Q8);
+  }
+  return estavel ? JARDIM_PERIODO_ESTAVEL_MS : ENERGIA_PERIODO_ECONOMIA_MS;
+}
+
+// Gerência de energia: economia quando não há botões nem rega por ENERGIA_OCIOSO_MS; a tela
+// escurece e depois apaga conforme o tempo desde o último botão
+static void tarefa_energia(void *ctx) {
+  uint64_t ocioso = hal_tempo_us() - energia_ultima_atividade_us();
+  bool ocupado = irrigacao_ocupada(&rega) || evento || buzzer_tocando();
+  energia_modo_t modo = (!ocupado && ocioso >= ENERGIA_OCIOSO_MS * 1000ull) ? ENERGIA_ECONOMIA : ENERGIA_NORMAL;
+  if (modo != energia_modo_atual() && !relogio_pedido) {
+    relogio_troca = relogio_troca + 1;
+    hal_barreira();
+    relogio_pedido = true;
+    hal_sinalizar();
+  } else if (modo == energia_modo_atual() && relogio_pedido) {
+    relogio_pedido = false; // Voltou ao modo atual antes da troca: libera o núcleo 1
+    hal_sinalizar();
+  }
+  relogio_modo = modo;
+  uint32_t periodo = periodo_controle();
+  if (periodo != periodo_ms) {
+    periodo_ms = periodo;
+    for (uint8_t i = 0; i < 3; ++i)
+      agenda_periodo(tarefas_periodicas[i], periodo);
+  }
+  tela = ocioso < ENERGIA_ESCURECER_MS * 1000ull ? TELA_LIGADA
+       : ocioso < ENERGIA_APAGAR_MS * 1000ull ? TELA_ESCURECIDA : TELA_APAGADA;
+}
+
+// Ação de um evento dos botões sobre a zona exibida. Na tela de valores, esquerdo e direito andam de
+// 10 em 10% a cada toque e, segurados, continuam nas repetições; o de confirmação soma 5 s ao tempo
+// de rega a cada clique (de 40 volta a 5) e, segurado, abre o gráfico da zona. No gráfico, esquerdo
+// e direito trocam a escala de tempo, o clique volta aos valores e, segurado, passa para a próxima zona.
+static void aplica_botao(const botao_evento_t *ev) {
+  uint8_t z = zona_exibida < zonas ? zona_exibida : 0;
+  if (grafico_exibido) {
+    if (ev->botao == BOTAO_ESQUERDO && ev->acao == BOTAO_PRESSIONADO && grafico_exibido > 1)
+      --grafico_exibido;
+    else if (ev->botao == BOTAO_DIREITO && ev->acao == BOTAO_PRESSIONADO && grafico_exibido < GRAFICO_ESCALAS)
+      ++grafico_exibido;
+    else if (ev->botao == BOTAO_CONFIRMA && ev->acao == BOTAO_CLIQUE)
+      grafico_exibido = 0;
+    else if (ev->botao == BOTAO_CONFIRMA && ev->acao == BOTAO_LONGO)
+      zona_exibida = (z + 1) % zonas;
+    return;
+  }
+  bool passo = ev->acao == BOTAO_PRESSIONADO || ev->acao == BOTAO_LONGO || ev->acao == BOTAO_REPETICAO;
+  if (ev->botao == BOTAO_ESQUERDO && passo) {
+    ideal[z] = ideal[z] > 10 ? ideal[z] - 10 : 0; // Limita o valor de umidade ideal em 0%
+  } else if (ev->botao == BOTAO_DIREITO && passo) {
+    ideal[z] = ideal[z] < 90 ? ideal[z] + 10 : 100; // Limita o valor de umidade ideal em 100%
+  } else if (ev->botao == BOTAO_CONFIRMA && ev->acao == BOTAO_CLIQUE) {
+    tempo_rega[z] = tempo_rega[z] < 40 ? tempo_rega[z] + 5 : 5; // Limita o tempo de rega em 40s
+  } else if (ev->botao == BOTAO_CONFIRMA && ev->acao == BOTAO_LONGO) {
+    grafico_exibido = 1;
+  }
+}
+
+// Botões: esvazia a fila de bordas da interrupção e aplica os eventos; volta sozinha enquanto
+// houver um prazo pendente (estabilização, toque longo ou repetição)
+static void le_botoes(void *ctx) {
+  int32_t espera_ms = botoes_processar();
+  botao_evento_t ev;
+  bool algum = false;
+  while (botoes_evento(&ev)) {
+    aplica_botao(&ev);
+    algum = true;
+  }
+  if (algum)
+    energia_atividade(); // Sai do modo economia e reacende a tela
+  if (espera_ms >= 0)
+    agenda_em(tarefa_botoes, espera_ms);
+  else
+    agenda_cancelar(tarefa_botoes);
+}
+
+// Coluna dos valores, alinhados pelo maior texto possível à esquerda da borda direita (x = 126)
+#define COLUNA_VALOR (WIDTH - 2 - FONT_MONO_WIDTH("100%", 1))
+
+// Fundo fixo do display e caixas dos valores (ver painel.h). Só mexe na memória: o primeiro envio
+// fica com o núcleo 1.
+static void compoe_tela(void) {
+  painel_init(&painel, ssd);
+  painel_fundo_inicio(&painel);
+  ssd1306_draw_string(ssd, "Umidade do solo:", 3, 16);
+  ssd1306_draw_string(ssd, "Umidade Ideal:", 3, 28); // Definições de parâmetros de rega
+  ssd1306_draw_string(ssd, "Tempo de Rega:", 3, 40);
+  ssd1306_rect(ssd, 1, 1, 126, 62, 1, 0); // Borda do display
+  painel_fundo_fim(&painel);
+
+  campo_zona = painel_campo(&painel, 3, 4, 16); // Zona da página e rótulo da luz: "Zona 2/4 Luz"
+  campo_luz = painel_campo(&painel, COLUNA_VALOR, 4, 4);
+  campo_umid = painel_campo(&painel, COLUNA_VALOR, 16, 4);
+  campo_ideal = painel_campo(&painel, COLUNA_VALOR, 28, 4);
+  campo_rega = painel_campo(&painel, COLUNA_VALOR, 40, 4);
+  campo_msg = painel_campo(&painel, 3, 52, 20); // Mensagem de estado da irrigação
+}
+
+void jardim_init(ssd1306_t *display, const zona_config_t *tabela, uint8_t total) {
+  ssd = display;
+  zonas = total > ZONAS_MAX ? ZONAS_MAX : total;
+  uint8_t pinos_rele[ZONAS_MAX];
+  for (uint8_t z = 0; z < zonas; ++z) {
+    pinos_rele[z] = tabela[z].pino_rele;
+    ideal[z] = tabela[z].ideal;
+    tempo_rega[z] = tabela[z].tempo_rega;
+  }
+  ajustes_carregar(ideal, tempo_rega, zonas); // Valores dos botões salvos antes do último reinício
+  irrigacao_init(&rega, pinos_rele, zonas); // Inicializa os pinos dos relés e as máquinas de estados da irrigação
+  zonas_init(tabela, zonas, adc_umidade); // Varredura inicial de todas as zonas
+  registro_init(); // Localiza o setor mais recente do histórico na flash
+  energia_init();
+
+  // Tarefas periódicas de controle, executadas na ordem de registro quando vencem juntas
+  tarefas_periodicas[0] = agenda_tarefa("sensores", tarefa_sensores, NULL);
+  tarefas_periodicas[1] = agenda_tarefa("rega", tarefa_rega, NULL);
+  tarefas_periodicas[2] = agenda_tarefa("publica", tarefa_publica, NULL);
+  tarefas_periodicas[3] = agenda_tarefa("energia", tarefa_energia, NULL);
+  for (uint8_t i = 0; i < 3; ++i)
+    agenda_periodo(tarefas_periodicas[i], 100);
+  agenda_periodo(tarefas_periodicas[3], 1000);
+
+  // Temporizadores únicos (continuações) da água e do alerta; o relé tem o seu próprio alarme em irrigacao.c
+  tarefa_agua = agenda_tarefa("agua", confere_agua, NULL);
+  tarefa_fim_alerta = agenda_tarefa("alerta", fim_alerta, NULL);
+  tarefa_botoes = agenda_tarefa("botoes", le_botoes, NULL);
+
+  compoe_tela();
+  grafico_init();
+  boot_init_us = hal_tempo_us();
+
+  PERFIL_REGISTRAR(perfil_sensores);
+  PERFIL_REGISTRAR(perfil_formata);
+  PERFIL_REGISTRAR(perfil_texto);
+  PERFIL_REGISTRAR(perfil_envio);
+  PERFIL_REGISTRAR(perfil_leds);
+  PERFIL_REGISTRAR(perfil_telemetria);
+  PERFIL_REGISTRAR(perfil_historico);
+}
+
+void jardim_rede(uint8_t endereco) {
+  rede_no_init(&rede_no, endereco, hal_tempo_us());
+  rede_ativa = true;
+}
+
+// Retrato para o coordenador, montado na hora da resposta: a zona regando muda pelo alarme do relé
+static void monta_retrato(rede_retrato_t *r) {
+  *r = (rede_retrato_t){
+    .zonas = zonas,
+    .irrigando = rega.ligada,
+    .alerta = alerta,
+    .falhas = falhas,
+    .luz = falhas & FALHA_LUZ ? 0 : q8_arredonda(adc_para_pct_q8(adc_value_luz)),
+    .regas = irrigacao_regas(&rega),
+  };
+  for (uint8_t z = 0; z < zonas; ++z) {
+    r->pedido |= rega.sede[z] && !rega.sem_agua;
+    r->umidade[z] = umidade[z] == ZONA_SEM_LEITURA ? REDE_SEM_LEITURA : q8_arredonda(umidade[z]);
+    r->ideal[z] = ideal[z];
+    r->rega[z] = tempo_rega[z];
+  }
+}
+
+// Quadros da rede: cada consulta a este nó é respondida na hora, depois de aplicado o ajuste que
+// ela trouxer (o retrato da resposta já confirma os valores novos). O envio bloqueia o núcleo 0 pelo
+// tempo do quadro, ~3,5 ms com 8 zonas; o desligamento do relé continua no alarme.
+static void atende_rede(void) {
+  uint8_t bytes[32];
+  size_t n;
+  while ((n = hal_uart_ler(bytes, sizeof bytes))) {
+    for (size_t i = 0; i < n; ++i) {
+      if (!rede_no_byte(&rede_no, bytes[i], hal_tempo_us()))
+        continue;
+      uint8_t z, novo_ideal, nova_rega;
+      if (rede_no_ajuste(&rede_no, &z, &novo_ideal, &nova_rega) && z < zonas) {
+        ideal[z] = novo_ideal > REDE_IDEAL_MAX ? REDE_IDEAL_MAX : novo_ideal; // Gravados na flash como os dos botões
+        tempo_rega[z] = nova_rega < REDE_REGA_MIN ? REDE_REGA_MIN : nova_rega > REDE_REGA_MAX ? REDE_REGA_MAX : nova_rega;
+      }
+      rede_retrato_t r;
+      uint8_t quadro[REDE_QUADRO_MAX];
+      monta_retrato(&r);
+      hal_uart_enviar(quadro, rede_no_responder(&rede_no, &r, quadro));
+    }
+  }
+}
+
+// Tarefa "rede" do coordenador: a próxima consulta quando vence o prazo (fim da espera pela resposta
+// ou início do ciclo). O envio bloqueia o núcleo 0 por ~1 ms; a resposta chega pela interrupção.
+static void coordena_rede(void *ctx) {
+  uint8_t quadro[REDE_QUADRO_MAX];
+  size_t total = rede_coord_passo(&rede_coord, hal_tempo_us(), quadro);
+  if (total)
+    hal_uart_enviar(quadro, total);
+  uint64_t prazo = rede_coord_prazo(&rede_coord), agora = hal_tempo_us();
+  agenda_em(tarefa_rede, prazo > agora ? (prazo - agora + 999) / 1000 : 0);
+}
+
+// Respostas dos nós e ajustes pedidos pela serial; uma resposta completa adianta a próxima consulta
+static void atende_coordenador(void) {
+  while (pedidos_cauda != pedidos_cabeca) {
+    hal_barreira(); // O pedido foi escrito antes da cabeça
+    const uint32_t i = pedidos_cauda % PEDIDOS_AJUSTE;
+    rede_coord_ajustar(&rede_coord, pedidos_ajuste[i].endereco, pedidos_ajuste[i].zona, pedidos_ajuste[i].ideal,
+                       pedidos_ajuste[i].rega); // Uma zona que o nó não tem fica de fora
+    pedidos_cauda = pedidos_cauda + 1;
+  }
+  uint8_t bytes[32];
+  size_t n;
+  while ((n = hal_uart_ler(bytes, sizeof bytes))) {
+    uint64_t agora = hal_tempo_us();
+    for (size_t i = 0; i < n; ++i)
+      rede_coord_byte(&rede_coord, bytes[i], agora);
+  }
+  if (rede_coord_prazo(&rede_coord) <= hal_tempo_us())
+    agenda_em(tarefa_rede, 0);
+}
+
+void jardim_coordenar(uint8_t nos, uint8_t bombas_max) {
+  rede_coord_init(&rede_coord, nos > REDE_NOS_MAX ? REDE_NOS_MAX : nos, bombas_max);
+  rede_coordenando = true;
+  tarefa_rede = agenda_tarefa("rede", coordena_rede, NULL);
+  agenda_em(tarefa_rede, 0);
+}
+
+const rede_coord_t *jardim_coordenador(void) {
+  return &rede_coord;
+}
+
+bool jardim_rede_ajustar(uint8_t endereco, uint8_t zona, uint8_t novo_ideal, uint8_t nova_rega) {
+  const uint32_t cabeca = pedidos_cabeca;
+  if (!rede_coordenando || !endereco || endereco > rede_coord.nos || zona >= ZONAS_MAX || novo_ideal > REDE_IDEAL_MAX ||
+      nova_rega < REDE_REGA_MIN || nova_rega > REDE_REGA_MAX || cabeca - pedidos_cauda >= PEDIDOS_AJUSTE)
+    return false;
+  pedidos_ajuste[cabeca % PEDIDOS_AJUSTE].endereco = endereco;
+  pedidos_ajuste[cabeca % PEDIDOS_AJUSTE].zona = zona;
+  pedidos_ajuste[cabeca % PEDIDOS_AJUSTE].ideal = novo_ideal;
+  pedidos_ajuste[cabeca % PEDIDOS_AJUSTE].rega = nova_rega;
+  hal_barreira();
+  pedidos_cabeca = cabeca + 1;
+  hal_sinalizar(); // Acorda o núcleo 0
+  return true;
+}
+
+uint64_t jardim_boot_us(void) {
+  return boot_decisao_us;
+}
+
+// Troca do relógio com o núcleo 1 parado (ver relogio_pedido)
+static void troca_relogio(void) {
+  energia_modo(relogio_modo);
+  agenda_periodo(tarefas_periodicas[3], relogio_modo == ENERGIA_ECONOMIA ? ENERGIA_PERIODO_ECONOMIA_MS : 1000);
+  relogio_pedido = false;
+  hal_barreira();
+  hal_sinalizar();
+}
+
+// Um passo do núcleo 0: tarefas vencidas ou sono até o próximo prazo. Um botão acorda o núcleo pela
+// interrupção, que só enfileira a borda; os eventos saem aqui e tiram da economia na hora, sem
+// esperar o próximo período. Um quadro da rede acorda do mesmo jeito, pela interrupção da UART.
+void jardim_controle(void) {
+  agenda_executar();
+  if (relogio_pedido && interface_parada == relogio_troca)
+    troca_relogio();
+  if (rede_ativa && hal_uart_pendente())
+    atende_rede();
+  if (rede_coordenando && (hal_uart_pendente() || pedidos_cauda != pedidos_cabeca))
+    atende_coordenador();
+  if (botoes_pendentes())
+    le_botoes(NULL);
+  if (energia_atividade_pendente())
+    tarefa_energia(NULL);
+}
+
+// Comando "A nó zona ideal rega" e Enter pela serial do coordenador (núcleo 1): ajuste de uma zona de
+// um nó, com a zona numerada como na tela. O início e o fim do comando contam como atividade: a
+// economia acaba e o resto da linha é lido a cada retrato, sem esperar o período longo.
+static void le_comando_ajuste(int c) {
+  comando_us = hal_tempo_us();
+  if (c != '\n' && c != '\r') {
+    if (!comando_total) {
+      energia_atividade();
+      hal_sinalizar(); // Acorda o núcleo 0, que sai da economia
+    }
+    if (comando_total < sizeof comando_ajuste - 1)
+      comando_ajuste[comando_total++] = (char)c;
+    return;
+  }
+  comando_ajuste[comando_total] = '\0';
+  comando_total = 0;
+  energia_atividade();
+  hal_sinalizar();
+  unsigned no, z, novo_ideal, nova_rega;
+  telemetria_descarregar(); // O texto nunca entra no meio de um quadro
+  if (sscanf(comando_ajuste, "A %u %u %u %u", &no, &z, &novo_ideal, &nova_rega) == 4 && no <= REDE_NOS_MAX &&
+      z >= 1 && z <= ZONAS_MAX && novo_ideal <= REDE_IDEAL_MAX && nova_rega <= REDE_REGA_MAX &&
+      jardim_rede_ajustar(no, z - 1, novo_ideal, nova_rega))
+    printf("Ajuste pedido: nó %u, zona %u, ideal %u%%, rega %u s\n", no, z, novo_ideal, nova_rega);
+  else
+    printf("Ajuste recusado: use A nó(1-%u) zona ideal(0-%d) rega(%d-%d)\n", rede_coord.nos, REDE_IDEAL_MAX,
+           REDE_REGA_MIN, REDE_REGA_MAX);
+}
+
+// Comandos pela serial (núcleo 1), tudo o que chegou desde o último passo, com ou sem retrato novo:
+// de um caractere e, no coordenador, "A ...". Um "A" sem Enter por JARDIM_COMANDO_MS é descartado,
+// e os comandos de um caractere voltam a valer.
+static void le_serial(void) {
+  if (comando_total && hal_tempo_us() - comando_us > JARDIM_COMANDO_MS * 1000ull)
+    comando_total = 0;
+  int c;
+  while ((c = hal_serial_ler()) >= 0) {
+    if (rede_coordenando && (comando_total || c == 'A')) {
+      le_comando_ajuste(c);
+      continue;
+    }
+    switch (c) {
+    case 'D':
+      telemetria_descarregar(); // Quadros pendentes saem inteiros antes da exportação
+      registro_exportar(); // Despeja o histórico (ver host/ler_registro.c)
+      break;
+    case 'P':
+      telemetria_descarregar();
+      perfil_relatorio(); // Tempo por etapa (ver perfil.h)
+      break;
+    case 'Z':
+      perfil_zerar();
+      break;
+    }
+  }
+}
+
+// Função de acionamento da Matriz de LEDs (núcleo 1): compõe o quadro inteiro em inteiros (a correção
+// gama fica na tabela do módulo matriz_leds) e só reenvia quando o quadro muda
+static void desenho(uint8_t nivel) {
+  uint8_t azul = nivel > 13 ? nivel - 13 : 0; // Azul levemente atenuado (5% abaixo)
+  matriz_leds_fill(nivel, nivel, azul);
+  matriz_leds_show();
+}
+
+// Composição e envio do display (núcleo 1)
+static void atualiza_display(const estado_t *e) {
+  uint8_t z = e->zona;
+  if (grafico_na_tela) {
+    painel_restaurar(&painel); // Volta do gráfico: fundo e todos os campos de novo
+    grafico_na_tela = 0;
+  }
+  PERFIL_INICIO(perfil_formata);
+  uint8_t n = 5 + fmt_uint(&str_zona[5], z + 1, '/'); // "Zona 2/4 Luz"
+  n += fmt_uint(&str_zona[n], e->zonas, ' ');
+  for (const char *c = "Luz"; *c; ++c)
+    str_zona[n++] = *c;
+  str_zona[n] = '\0';
+  if (e->falhas & FALHA_LUZ) {
+    str_luz[0] = '-';
+    str_luz[1] = '\0';
+  } else {
+    fmt_uint(str_luz, q8_arredonda(adc_para_pct_q8(e->adc_luz)), '%');  // Converte o inteiro em string
+  }
+  if (e->umidade[z] == ZONA_SEM_LEITURA) {
+    str_umid[0] = '-';
+    str_umid[1] = '\0';
+  } else {
+    fmt_uint(str_umid, q8_arredonda(e->umidade[z]), '%');  // Converte o valor percentual em string
+  }
+  fmt_uint(str_ideal, e->ideal[z], '%');  // Converte o inteiro em string
+  fmt_uint(str_rega, e->tempo_rega[z], 's');  // Converte o inteiro em string
+  PERFIL_FIM(perfil_formata);
+
+  PERFIL_INICIO(perfil_texto);
+  painel_texto(&painel, campo_zona, str_zona); // Cada campo só é redesenhado se o texto mudou
+  painel_texto(&painel, campo_luz, str_luz);
+  painel_texto(&painel, campo_umid, str_umid);
+  painel_texto(&painel, campo_ideal, str_ideal);
+  painel_texto(&painel, campo_rega, str_rega);
+  painel_texto(&painel, campo_msg, e->msg_rega);
+  PERFIL_FIM(perfil_texto);
+
+  PERFIL_INICIO(perfil_envio);
+  painel_enviar(&painel); // Atualiza o display em segundo plano, enviando apenas as regiões alteradas
+  PERFIL_FIM(perfil_envio);
+}
+
+// Gráfico do histórico recente (grafico.h): título na página 0, umidade da zona nas páginas 1 a 4 e
+// luminosidade nas páginas 5 a 7, uma coluna por posição do anel e a mais recente na borda direita
+#define GRAFICO_X0 (WIDTH - GRAFICO_COLUNAS)
+#define GRAFICO_UMID_Y0 9
+#define GRAFICO_UMID_Y1 37
+#define GRAFICO_LUZ_Y0 43
+#define GRAFICO_LUZ_Y1 63
+
+// Valor em % para a linha da tela, 100% em y0
+static inline uint8_t grafico_y(uint8_t pct, uint8_t y0, uint8_t y1) {
+  return y1 - (uint16_t)pct * (y1 - y0) / 100;
+}
+
+// Uma coluna: faixa vertical do mínimo ao máximo de cada série (nada nas colunas sem amostras)
+static void desenha_coluna(uint8_t x, uint8_t z, uint8_t escala, uint8_t idade) {
+  uint8_t min, max;
+  ssd1306_vline(ssd, x, 8, HEIGHT - 1, 0);
+  if (grafico_coluna(z, escala, idade, &min, &max))
+    ssd1306_vline(ssd, x, grafico_y(max, GRAFICO_UMID_Y0, GRAFICO_UMID_Y1), grafico_y(min, GRAFICO_UMID_Y0, GRAFICO_UMID_Y1), 1);
+  if (grafico_coluna(GRAFICO_LUZ, escala, idade, &min, &max))
+    ssd1306_vline(ssd, x, grafico_y(max, GRAFICO_LUZ_Y0, GRAFICO_LUZ_Y1), grafico_y(min, GRAFICO_LUZ_Y0, GRAFICO_LUZ_Y1), 1);
+}
+
+// Tela inteira do gráfico, ao entrar nele, ao trocar de zona ou escala e depois de colunas perdidas
+// com o display apagado
+static void compoe_grafico(uint8_t z, uint8_t escala) {
+  char titulo[8] = "Zona ";
+  fmt_uint(&titulo[5], z + 1, '\0');
+  const char *nome = grafico_escala_nome(escala);
+  ssd1306_fill(ssd, 0);
+  ssd1306_draw_string(ssd, titulo, 0, 0);
+  ssd1306_draw_text(ssd, &font_6x8, nome, WIDTH - strlen(nome) * FONT_6X8_WIDTH, 0, 1);
+  ssd1306_draw_string(ssd, "Umid", 0, 19);
+  ssd1306_draw_string(ssd, "Luz", 0, 49);
+  ssd1306_vline(ssd, GRAFICO_X0 - 1, 8, HEIGHT - 1, 1); // Eixo, fora da área que rola
+  for (uint8_t i = 0; i < GRAFICO_COLUNAS; ++i)
+    desenha_coluna(WIDTH - 1 - i, z, escala, i);
+}
+
+// Atualização do gráfico (núcleo 1). A cada coluna nova a área do gráfico rola uma coluna para a
+// esquerda no próprio controlador e só a coluna nova é desenhada e enviada: ~8 bytes de comando e
+// uma coluna de 7 páginas, em vez das 96 colunas da área.
+static void atualiza_grafico(const estado_t *e) {
+  uint8_t escala = e->grafico - 1;
+  uint32_t colunas = grafico_colunas(escala);
+  if (e->grafico != grafico_na_tela || e->zona != grafico_zona || colunas - grafico_desenhadas > 1) {
+    compoe_grafico(e->zona, escala);
+  } else if (colunas != grafico_desenhadas) {
+    ssd1306_scroll_left(ssd, 1, ssd->pages - 1, GRAFICO_X0, WIDTH - 1);
+    desenha_coluna(WIDTH - 1, e->zona, escala, 0);
+  }
+  grafico_na_tela = e->grafico;
+  grafico_zona = e->zona;
+  grafico_desenhadas = colunas;
+  PERFIL_INICIO(perfil_envio);
+  ssd1306_send_data_async(ssd); // Com um envio em andamento, as colunas ficam marcadas para o próximo
+  PERFIL_FIM(perfil_envio);
+}
+
+// Amostras do retrato para o gráfico: umidade de cada zona com leitura e luminosidade, em %
+static void alimenta_grafico(const estado_t *e) {
+  grafico_avancar(hal_tempo_us() / 1000);
+  for (uint8_t z = 0; z < e->zonas; ++z)
+    if (e->umidade[z] != ZONA_SEM_LEITURA)
+      grafico_amostra(z, q8_arredonda(e->umidade[z]));
+  if (!(e->falhas & FALHA_LUZ))
+    grafico_amostra(GRAFICO_LUZ, q8_arredonda(adc_para_pct_q8(e->adc_luz)));
+}
+
+// Telemetria pela serial (núcleo 1): uma amostra binária por zona a cada retrato, enviadas em lotes (ver telemetria.h)
+static void telemetria(const estado_t *e) {
+  uint32_t t_ms = hal_tempo_us() / 1000;
+  for (uint8_t z = 0; z < e->zonas; ++z) {
+    telemetria_amostra_t a = {
+      .t_ms = t_ms,
+      .zona = z,
+      .luz = e->adc_luz,
+      .umidade_adc = e->adc_umidade[z],
+      .umidade = e->umidade[z],
+      .rele = e->irrigando == z,
+      .alerta = e->alerta,
+      .tela = e->tela,
+      .ideal = e->ideal[z],
+      .tempo_rega = e->tempo_rega[z],
+    };
+    telemetria_adicionar(&a);
+  }
+  telemetria_enviar();
+}
+
+// Contraste mínimo ou display desligado quando ocioso (núcleo 1, dono do barramento do display). O
+// display sai de ssd1306_config desligado e só liga depois que o primeiro quadro foi enviado.
+static void aplica_tela(tela_t nova) {
+  static tela_t aplicada = TELA_APAGADA;
+  if (nova == aplicada)
+    return;
+  if (nova == TELA_APAGADA) {
+    ssd1306_command(ssd, SET_DISP | 0x00);
+  } else {
+    uint8_t comandos[3] = {SET_DISP | 0x01, SET_CONTRAST, nova == TELA_LIGADA ? 0xFF : 0x01};
+    bool ligar = aplicada == TELA_APAGADA;
+    ssd1306_command_list(ssd, ligar ? comandos : comandos + 1, ligar ? 3 : 2); // Uma transação
+  }
+  aplicada = nova;
+  energia_tela(nova);
+}
+
+static void historico_zona(const estado_t *e, uint8_t z, uint64_t agora) {
+  registro_amostra_t a = {
+    .t = agora / 100000,
+    .zona = z,
+    .luz = e->adc_luz,
+    .umidade = e->adc_umidade[z],
+    .rele = e->irrigando == z,
+    .alerta = e->alerta,
+  };
+  registro_adicionar(&a);
+}
+
+// Histórico na flash: uma amostra de cada zona por minuto, uma da zona que liga ou desliga o relé e
+// uma da zona regando (ou da primeira) a cada mudança do alerta
+static void historico(const estado_t *e) {
+  static uint64_t proxima_amostra;
+  static int8_t irrigando_anterior = -1;
+  static alerta_t alerta_anterior;
+  uint64_t agora = hal_tempo_us();
+  if (agora >= proxima_amostra) {
+    for (uint8_t z = 0; z < e->zonas; ++z)
+      historico_zona(e, z, agora);
+    proxima_amostra = agora + REGISTRO_INTERVALO_MS * 1000ull;
+  } else {
+    if (e->irrigando != irrigando_anterior) {
+      if (irrigando_anterior >= 0)
+        historico_zona(e, irrigando_anterior, agora);
+      if (e->irrigando >= 0)
+        historico_zona(e, e->irrigando, agora);
+    } else if (e->alerta != alerta_anterior) {
+      historico_zona(e, e->irrigando >= 0 ? e->irrigando : 0, agora);
+    }
+  }
+  irrigando_anterior = e->irrigando;
+  alerta_anterior = e->alerta;
+}
+
+// Uma linha por sensor: média e desvio da última janela, inclinação e defeito; na umidade, tempo
+// previsto até o limiar de rega. Só lê a estatística do núcleo 0.
+static void relatorio_sensor(const char *nome, const estat_t *s, int8_t ideal_zona) {
+  int32_t inclinacao = s->inclinacao_q8 * 100 / 4095; // %/h, Q8
+  uint32_t desvio = s->desvio_q8 * 100 / 256; // Centésimos de contagem
+  printf("  %s: média %u, desvio %lu.%02lu, %s%ld.%02ld %%/h, %s", nome, estat_media(s), (unsigned long)(desvio / 100),
+         (unsigned long)(desvio % 100), inclinacao < 0 ? "-" : "", (long)(labs(inclinacao) >> 8),
+         (long)((labs(inclinacao) & 0xFF) * 100 >> 8), estat_falha_nome(s->falha));
+  int32_t t = ideal_zona >= 0 && !s->falha ? estat_tempo_ate(s, pct_para_adc(ideal_zona > 20 ? ideal_zona - 20 : 0)) : -1;
+  if (t >= 0)
+    printf(", limiar de rega em %ld min", (long)(t / 60));
+  printf("\n");
+}
+
+void jardim_relatorio_sensores(void) {
+  printf("Sensores: leituras a cada %lu ms\n", (unsigned long)periodo_ms);
+  relatorio_sensor("luz", &estat_luz, -1);
+  char nome[8] = "zona ";
+  for (uint8_t z = 0; z < zonas; ++z) {
+    fmt_uint(&nome[5], z + 1, '\0');
+    relatorio_sensor(nome, &estat_umidade[z], ideal[z]);
+  }
+}
+
+// Um passo do núcleo 1: display, matriz de LEDs e telemetria, sempre a partir do retrato mais recente.
+// Um display ou uma serial lentos só atrasam este núcleo, nunca o desligamento da bomba no núcleo 0.
+bool jardim_interface(void) {
+  static uint64_t proximo_relatorio = 10000000;
+  if (relogio_pedido) {
+    // Espera ativa só até o fim dos envios em andamento; parado, dorme até o núcleo 0 liberar
+    if (ssd1306_busy(ssd) || matriz_leds_busy())
+      return true;
+    uint32_t troca = relogio_troca;
+    if (interface_parada != troca) {
+      interface_parada = troca;
+      hal_barreira();
+      hal_sinalizar();
+    }
+    return false;
+  }
+  estado_t e;
+  if (!estado_consumir(&e)) {
+    le_serial(); // Os comandos não esperam o próximo retrato
+    return false;
+  }
+  PERFIL_INICIO(perfil_leds);
+  desenho(e.intensidade); // Atualiza a matriz de LEDs de acordo com a intensidade de luz
+  PERFIL_FIM(perfil_leds);
+  alimenta_grafico(&e);
+  if (e.tela != TELA_APAGADA && e.grafico)
+    atualiza_grafico(&e);
+  else if (e.tela != TELA_APAGADA)
+    atualiza_display(&e); // Com o display desligado a memória dele não muda: nada a compor nem enviar
+  aplica_tela(e.tela); // Depois do quadro: ao religar, a tela já aparece atualizada
+  PERFIL_INICIO(perfil_telemetria);
+  telemetria(&e);
+  PERFIL_FIM(perfil_telemetria);
+  PERFIL_INICIO(perfil_historico);
+  historico(&e);
+  // Flash: no máximo uma operação por passo entre histórico e ajustes, e nenhuma com um relé ligado
+  // (o núcleo 0 fica parado durante a operação; ver registro.h). O relé só liga pelo núcleo 0, então
+  // com rega.ligada lido agora só uma rega que comece antes de o núcleo 0 parar cai na operação.
+  if (e.irrigando < 0 && rega.ligada < 0 && !registro_executar())
+    ajustes_executar(e.ideal, e.tempo_rega, e.zonas); // Grava os ajustes dos botões depois de estáveis
+  PERFIL_FIM(perfil_historico);
+  le_serial();
+  if (hal_tempo_us() >= proximo_relatorio) {
+    telemetria_descarregar(); // O texto nunca entra no meio de um quadro
+    agenda_relatorio(); // Latência e jitter das tarefas do núcleo 0
+    irrigacao_relatorio(&rega); // Tempo de bomba e uso do pool de alarmes
+    agua_relatorio(); // Água entregue por zona e regas cortadas a seco
+    energia_relatorio(); // Residência por modo e carga estimada por amostra
+    jardim_relatorio_sensores(); // Estatística das leituras e defeitos dos sensores
+    if (rede_ativa)
+      printf("Rede: nó %u, %lu consultas, %lu quadros corrompidos, %s\n", rede_no.endereco,
+             (unsigned long)rede_no.consultas, (unsigned long)rede_no.corrompidos,
+             rede_no.liberado ? "com a vez da bomba" : rede_no_liberado(&rede_no, hal_tempo_us()) ? "sozinho (sem consultas)" : "sem a vez");
+    if (rede_coordenando)
+      rede_coord_relatorio(&rede_coord, hal_tempo_us()); // Nós, vezes da bomba e tempo do ciclo de consultas
+    printf("Retratos descartados: %lu, amostras do histórico perdidas: %lu, quadros de telemetria descartados: %lu\n",
+           (unsigned long)estado_descartados(), (unsigned long)registro_perdidas(),
+           (unsigned long)telemetria_descartados());
+    printf("Boot: %lu ms até a primeira decisão de rega (%lu ms até o fim da inicialização), ajustes %s, %lu gravações\n",
+           (unsigned long)(boot_decisao_us / 1000), (unsigned long)(boot_init_us / 1000),
+           ajustes_carregados() ? "da flash" : "da tabela", (unsigned long)ajustes_gravacoes());
+    proximo_relatorio = hal_tempo_us() + 10000000;
+  }
+  return true;
+}
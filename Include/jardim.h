@@ -0,0 +1,40 @@
+#ifndef JARDIM_H
+#define JARDIM_H
+
+#include "hal.h"
+#include "ssd1306.h"
+#include "irrigacao.h"
+#include "zonas.h"
+#include "rede.h"
+
+// Lógica da aplicação, independente da placa: tarefas de controle do núcleo 0 (sensores, rega,
+// alerta, publicação do retrato) e a interface do núcleo 1 (display, matriz de LEDs, telemetria).
+// Só usa a HAL, então roda igual no RP2040 (Garden.c) e na simulação de host (host/sim_garden.c).
+
+#define JARDIM_PAGINA_MS 4000 // Tempo de cada zona na tela
+#define JARDIM_PAGINA_PAUSA_MS 15000 // Sem trocar de página por este tempo após um botão
+#define JARDIM_COMANDO_MS 10000 // Comando "A" da serial sem Enter por este tempo é descartado
+
+// Cadência do controle em economia, decidida pela estatística das leituras de umidade
+#define JARDIM_PERIODO_ESTAVEL_MS 30000 // Todas as zonas paradas: leituras espaçadas
+#define JARDIM_PERIODO_TENDENCIA_MS 1000 // Alguma zona a caminho do limiar de rega (ideal - 20%)
+#define JARDIM_HORIZONTE_S 1800 // Tempo previsto até o limiar que já acelera as leituras
+#define JARDIM_ESTAVEL_DESVIO 4 // Desvio padrão máximo (contagens do ADC) de uma leitura parada
+#define JARDIM_ESTAVEL_PCT_H 1 // Inclinação máxima (%/h) de uma leitura parada
+
+extern volatile int8_t ideal[ZONAS_MAX]; // Umidade ideal do solo (%) por zona, ajustada pelos botões
+extern volatile int8_t tempo_rega[ZONAS_MAX]; // Tempo de rega (s) por zona, ajustado pelos botões
+extern volatile uint8_t zona_exibida; // Zona na tela, a que os botões ajustam
+extern irrigacao_t rega; // Estado da irrigação e contabilidade dos relés
+
+void jardim_init(ssd1306_t *display, const zona_config_t *tabela, uint8_t zonas); // Registra as tarefas na agenda
+void jardim_rede(uint8_t endereco); // Nó da rede RS-485 (rede.h), depois de hal_uart_init; sem ela a placa rega sozinha
+void jardim_coordenar(uint8_t nos, uint8_t bombas_max); // Coordenador dos nós 1 a nos, depois de hal_uart_init; a bomba desta placa fica fora do orçamento
+const rede_coord_t *jardim_coordenador(void); // Estado do coordenador (fora do núcleo 0, só para relatórios)
+bool jardim_rede_ajustar(uint8_t endereco, uint8_t zona, uint8_t ideal, uint8_t rega); // Pedido do núcleo 1 ao coordenador; false fora dos limites ou com a fila cheia
+void jardim_controle(void); // Um passo do núcleo 0
+bool jardim_interface(void); // Um passo do núcleo 1; false quando não havia retrato novo
+void jardim_relatorio_sensores(void); // Estatística das leituras e defeitos (só lê; chamada pelo núcleo 1)
+uint64_t jardim_boot_us(void); // Do reset à primeira decisão de rega (0 = ainda não houve)
+
+#endif
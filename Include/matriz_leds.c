@@ -0,0 +1,116 @@
+#include "matriz_leds.h"
+
+// Curva gama 2.2 (entrada linear 0-255 -> nível PWM do WS2812), fica na flash
+static const uint8_t gama[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+    3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+    6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+   12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+   20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+   30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+   42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+   56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+   73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+   91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+  113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+  137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+  163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+  192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+  223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+static uint8_t lut[256]; // gama combinada com o brilho global, recalculada apenas quando o brilho muda
+static uint8_t fitas = 1;
+static uint32_t quadro[MATRIZ_FITAS_MAX * MATRIZ_LEDS]; // Quadro sendo composto (formato GRB do programa matriz.pio)
+// Cópia lida pelo DMA, isolada de alterações durante o envio: uma palavra GRB por LED com uma fita,
+// 24 bytes transpostos por posição com várias
+static uint32_t envio[MATRIZ_LEDS * MATRIZ_BITS_LED / 4];
+static bool alterado; // Há diferença entre quadro e o último quadro enviado
+
+void matriz_leds_init(uint pino, uint8_t total_fitas) {
+  fitas = total_fitas < 1 ? 1 : total_fitas > MATRIZ_FITAS_MAX ? MATRIZ_FITAS_MAX : total_fitas;
+  hal_leds_init(pino, fitas); // Programa matriz.pio (ou matriz_paralelo) e canal DMA para o FIFO TX
+
+  matriz_leds_set_brilho(255);
+  alterado = true; // Garante que o primeiro show apague os LEDs
+}
+
+void matriz_leds_set_brilho(uint8_t brilho) {
+  for (uint16_t i = 0; i < 256; ++i)
+    lut[i] = (gama[i] * brilho + 127) / 255;
+}
+
+void matriz_leds_set(uint16_t led, uint8_t r, uint8_t g, uint8_t b) {
+  if (led >= fitas * MATRIZ_LEDS)
+    return;
+  uint32_t valor = ((uint32_t)lut[g] << 24) | ((uint32_t)lut[r] << 16) | ((uint32_t)lut[b] << 8);
+  if (quadro[led] != valor) {
+    quadro[led] = valor;
+    alterado = true;
+  }
+}
+
+void matriz_leds_fill(uint8_t r, uint8_t g, uint8_t b) {
+  for (uint16_t led = 0; led < fitas * MATRIZ_LEDS; ++led)
+    matriz_leds_set(led, r, g, b);
+}
+
+bool matriz_leds_busy(void) {
+  return hal_leds_ocupado();
+}
+
+// Transposição 8x8 de bits em duas palavras de 32 bits (Hacker's Delight, transpose8): o M0+ não tem
+// deslocamento de 64 bits. Entrada: byte i = fita i (y = fitas 0-3, x = fitas 4-7); saída: byte j =
+// bit j de cada fita.
+static inline void transpor8(uint32_t *x, uint32_t *y) {
+  uint32_t t;
+  t = (*x ^ (*x >> 7)) & 0x00AA00AAu; *x ^= t ^ (t << 7);
+  t = (*y ^ (*y >> 7)) & 0x00AA00AAu; *y ^= t ^ (t << 7);
+  t = (*x ^ (*x >> 14)) & 0x0000CCCCu; *x ^= t ^ (t << 14);
+  t = (*y ^ (*y >> 14)) & 0x0000CCCCu; *y ^= t ^ (t << 14);
+  t = (*x & 0xF0F0F0F0u) | ((*y >> 4) & 0x0F0F0F0Fu);
+  *y = ((*x << 4) & 0xF0F0F0F0u) | (*y & 0x0F0F0F0Fu);
+  *x = t;
+}
+
+void matriz_leds_transpor(const uint32_t *grb, uint8_t total, uint8_t leds, uint8_t *planos) {
+  for (uint8_t led = 0; led < leds; ++led) {
+    for (uint8_t desloc = 24; desloc >= 8; desloc -= 8) { // G, R e B, o bit mais significativo primeiro
+      uint32_t x = 0, y = 0;
+      for (uint8_t f = 0; f < total; ++f) {
+        uint32_t byte = (grb[f * leds + led] >> desloc) & 0xFF;
+        if (f < 4)
+          y |= byte << (8 * f);
+        else
+          x |= byte << (8 * (f - 4));
+      }
+      transpor8(&x, &y);
+      *planos++ = x >> 24; // Bit 7
+      *planos++ = x >> 16;
+      *planos++ = x >> 8;
+      *planos++ = x;
+      *planos++ = y >> 24;
+      *planos++ = y >> 16;
+      *planos++ = y >> 8;
+      *planos++ = y; // Bit 0
+    }
+  }
+}
+
+// Envia o quadro via DMA para o FIFO TX da máquina de estados, somente se ele mudou desde o último envio.
+// Retorna true se um envio foi iniciado; se o DMA ainda estiver ocupado, o quadro fica pendente.
+bool matriz_leds_show(void) {
+  if (!alterado || matriz_leds_busy())
+    return false;
+  alterado = false;
+  if (fitas == 1) {
+    for (uint8_t led = 0; led < MATRIZ_LEDS; ++led)
+      envio[led] = quadro[led];
+    hal_leds_enviar(envio, MATRIZ_LEDS);
+  } else {
+    matriz_leds_transpor(quadro, fitas, MATRIZ_LEDS, (uint8_t *)envio);
+    hal_leds_enviar(envio, MATRIZ_LEDS * MATRIZ_BITS_LED / 4);
+  }
+  return true;
+}
@@ -0,0 +1,26 @@
+#ifndef MATRIZ_LEDS_H
+#define MATRIZ_LEDS_H
+
+#include "hal.h"
+
+// Matriz de LEDs WS2812: uma fita (o painel 5x5) no programa matriz, ou até MATRIZ_FITAS_MAX fitas
+// ou painéis em pinos consecutivos, todos transmitidos ao mesmo tempo pelo programa matriz_paralelo.
+// Com várias fitas o quadro é transposto (um byte por bit de LED, um bit por fita) antes do DMA, e o
+// envio leva o tempo de uma fita só em vez de crescer com o encadeamento.
+
+#define MATRIZ_LEDS 25 // Por fita
+#define MATRIZ_FITAS_MAX 8
+#define MATRIZ_BITS_LED 24
+
+void matriz_leds_init(uint pino, uint8_t fitas); // Fitas nos pinos pino .. pino + fitas - 1
+void matriz_leds_set_brilho(uint8_t brilho);
+void matriz_leds_set(uint16_t led, uint8_t r, uint8_t g, uint8_t b); // led = fita * MATRIZ_LEDS + posição
+void matriz_leds_fill(uint8_t r, uint8_t g, uint8_t b);
+bool matriz_leds_show(void);
+bool matriz_leds_busy(void);
+
+// Transpõe leds x fitas palavras GRB (grb[fita * leds + led]) em leds x 24 bytes: o byte k do LED
+// traz o bit 23 - k de cada fita, a fita f no bit f. Exposta para o benchmark do host.
+void matriz_leds_transpor(const uint32_t *grb, uint8_t fitas, uint8_t leds, uint8_t *planos);
+
+#endif
@@ -0,0 +1,115 @@
+#include <string.h>
+#include "painel.h"
+
+void painel_init(painel_t *p, ssd1306_t *ssd) {
+  *p = (painel_t){.ssd = ssd};
+  p->fundo = calloc(ssd->bufsize, sizeof(uint8_t));
+}
+
+void painel_fundo_inicio(painel_t *p) {
+  ssd1306_fill(p->ssd, 0);
+}
+
+void painel_fundo_fim(painel_t *p) {
+  ssd1306_t *ssd = p->ssd;
+  memcpy(p->fundo, ssd->ram_buffer, ssd->bufsize);
+  for (uint8_t i = 0; i < p->total_campos; ++i)
+    p->campos[i].valido = false;
+  // O fundo foi desenhado com as primitivas do driver, que já marcaram o que mudou
+}
+
+void painel_restaurar(painel_t *p) {
+  ssd1306_t *ssd = p->ssd;
+  memcpy(ssd->ram_buffer, p->fundo, ssd->bufsize);
+  for (uint8_t i = 0; i < p->total_campos; ++i)
+    p->campos[i].valido = false;
+  p->total_regioes = 0;
+  ssd1306_invalidate(ssd); // A outra tela pode ter mudado qualquer byte
+}
+
+int8_t painel_campo(painel_t *p, uint8_t x, uint8_t y, uint8_t largura) {
+  if (p->total_campos >= PAINEL_CAMPOS)
+    return -1;
+  p->campos[p->total_campos] = (painel_campo_t){
+    .x = x,
+    .y = y,
+    .largura = largura > PAINEL_TEXTO_MAX ? PAINEL_TEXTO_MAX : largura,
+  };
+  return p->total_campos++;
+}
+
+// Acrescenta uma região à lista; cheia, a última cresce até cobrir a nova
+static void sujar(painel_t *p, painel_regiao_t r) {
+  if (p->total_regioes < PAINEL_REGIOES) {
+    p->regioes[p->total_regioes++] = r;
+    return;
+  }
+  painel_regiao_t *u = &p->regioes[PAINEL_REGIOES - 1];
+  if (r.x0 < u->x0) u->x0 = r.x0;
+  if (r.y0 < u->y0) u->y0 = r.y0;
+  if (r.x1 > u->x1) u->x1 = r.x1;
+  if (r.y1 > u->y1) u->y1 = r.y1;
+}
+
+// Grava as linhas da máscara de um byte do buffer: fundo com o texto por cima. Retorna se o byte mudou.
+static inline bool compor(uint8_t *ram, const uint8_t *fundo, uint16_t i, uint8_t mascara, uint8_t texto) {
+  uint8_t novo = (ram[i] & ~mascara) | ((fundo[i] | texto) & mascara);
+  if (novo == ram[i])
+    return false;
+  ram[i] = novo;
+  return true;
+}
+
+bool painel_texto(painel_t *p, int8_t campo, const char *texto) {
+  if (campo < 0 || campo >= p->total_campos)
+    return false;
+  painel_campo_t *c = &p->campos[campo];
+  if (c->valido && !strncmp(c->texto, texto, c->largura) && strlen(texto) <= c->largura)
+    return false;
+  strncpy(c->texto, texto, c->largura);
+  c->texto[c->largura] = '\0';
+  c->valido = true;
+  ++p->redesenhos;
+
+  // A caixa tem 8 linhas a partir de y: cobre uma página ou parte de duas (endereçamento vertical:
+  // as páginas de uma coluna são bytes consecutivos de ram_buffer)
+  ssd1306_t *ssd = p->ssd;
+  uint8_t pagina = c->y >> 3, desloc = c->y & 7;
+  bool segunda = desloc && pagina + 1 < ssd->pages;
+  uint8_t mascara0 = 0xFF << desloc, mascara1 = 0xFF >> (8 - desloc);
+  const char *s = c->texto;
+  const uint8_t *glifo = NULL;
+  int16_t x0 = -1, x1 = -1;
+  for (uint16_t i = 0; i < c->largura * FONT_6X8_WIDTH && c->x + i < ssd->width; ++i) {
+    uint8_t coluna = i % FONT_6X8_WIDTH;
+    if (coluna == 0)
+      glifo = font_glyph(&font_6x8, *s ? *s++ : ' ', NULL);
+    uint8_t x = c->x + i;
+    uint16_t indice = (x << 3) + pagina;
+    bool mudou = compor(ssd->ram_buffer, p->fundo, indice, mascara0, glifo[coluna] << desloc);
+    if (segunda)
+      mudou |= compor(ssd->ram_buffer, p->fundo, indice + 1, mascara1, glifo[coluna] >> (8 - desloc));
+    if (mudou) {
+      if (x0 < 0)
+        x0 = x;
+      x1 = x;
+    }
+  }
+  if (x0 >= 0) {
+    uint8_t y1 = c->y + 7 < ssd->height ? c->y + 7 : ssd->height - 1;
+    sujar(p, (painel_regiao_t){x0, c->y, x1, y1});
+  }
+  return true;
+}
+
+bool painel_enviar(painel_t *p) {
+  if (ssd1306_busy(p->ssd))
+    return false;
+  for (uint8_t i = 0; i < p->total_regioes; ++i) {
+    painel_regiao_t *r = &p->regioes[i];
+    ssd1306_mark_region(p->ssd, r->x0, r->y0, r->x1, r->y1);
+  }
+  p->regioes_enviadas += p->total_regioes;
+  p->total_regioes = 0;
+  return ssd1306_send_data_async(p->ssd);
+}
@@ -0,0 +1,52 @@
+#ifndef PAINEL_H
+#define PAINEL_H
+
+#include "ssd1306.h"
+
+// Interface retida sobre o ssd1306: o fundo (rótulos e bordas) é composto uma única vez em um
+// buffer próprio e os valores variáveis são campos de texto com caixa fixa. Um campo só é
+// redesenhado quando o texto muda: a caixa volta ao fundo, o texto é escrito por cima, coluna a
+// coluna, e o trecho que realmente mudou entra na lista de regiões sujas. painel_enviar entrega a
+// lista ao driver, que transmite só essas colunas.
+//
+// Antes, cada quadro limpava a tela e redesenhava tudo; os bytes apagados e reescritos iguais
+// ficavam marcados como alterados e quase a tela inteira ia pelo I2C a cada atualização.
+
+#define PAINEL_CAMPOS 8
+#define PAINEL_TEXTO_MAX 20 // Caracteres por campo
+#define PAINEL_REGIOES 16
+
+typedef struct {
+  uint8_t x0, y0, x1, y1; // Pixels, inclusive
+} painel_regiao_t;
+
+typedef struct {
+  uint8_t x, y, largura; // Canto superior esquerdo e largura em caracteres (6 x 8 pixels cada)
+  bool valido; // texto corresponde ao que está na tela
+  char texto[PAINEL_TEXTO_MAX + 1];
+} painel_campo_t;
+
+typedef struct {
+  ssd1306_t *ssd;
+  uint8_t *fundo; // Mesmo formato de ssd->ram_buffer
+  painel_campo_t campos[PAINEL_CAMPOS];
+  uint8_t total_campos;
+  painel_regiao_t regioes[PAINEL_REGIOES];
+  uint8_t total_regioes;
+  uint32_t redesenhos, regioes_enviadas;
+} painel_t;
+
+void painel_init(painel_t *p, ssd1306_t *ssd);
+
+// Composição do fundo: entre as duas chamadas o buffer do display é desenhado com as primitivas do
+// ssd1306; o resultado vira o fundo e todos os campos são redesenhados na próxima atualização
+void painel_fundo_inicio(painel_t *p);
+void painel_fundo_fim(painel_t *p);
+
+void painel_restaurar(painel_t *p); // Volta ao fundo depois de outra tela desenhada direto no buffer; tudo é reenviado
+
+int8_t painel_campo(painel_t *p, uint8_t x, uint8_t y, uint8_t largura); // Índice do campo ou -1 sem espaço
+bool painel_texto(painel_t *p, int8_t campo, const char *texto); // true se o campo foi redesenhado
+bool painel_enviar(painel_t *p); // Marca as regiões no driver e inicia o envio; false com o envio anterior em andamento
+
+#endif
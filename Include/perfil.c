@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include "perfil.h"
+
+static perfil_etapa_t *etapas, **ultima = &etapas; // Lista em ordem de registro, montada na inicialização
+static volatile uint32_t geracao;
+
+void perfil_registrar(perfil_etapa_t *e) {
+  e->geracao = geracao - 1; // Zerada na primeira medição
+  e->proxima = NULL;
+  *ultima = e;
+  ultima = &e->proxima;
+}
+
+void perfil_medir(perfil_etapa_t *e, uint32_t ciclos) {
+  if (e->geracao != geracao) {
+    e->execucoes = 0;
+    e->min = UINT32_MAX;
+    e->max = 0;
+    e->soma = 0;
+    for (uint8_t i = 0; i < PERFIL_BALDES; ++i)
+      e->histograma[i] = 0;
+    e->geracao = geracao;
+  }
+  e->execucoes++;
+  e->soma += ciclos;
+  if (ciclos < e->min)
+    e->min = ciclos;
+  if (ciclos > e->max)
+    e->max = ciclos;
+  uint8_t balde = ciclos > 1 ? 31 - __builtin_clz(ciclos) : 0;
+  e->histograma[balde < PERFIL_BALDES ? balde : PERFIL_BALDES - 1]++;
+}
+
+// Uma linha por etapa (ciclos) e, abaixo, os baldes não vazios do histograma como 2^i:contagem
+void perfil_relatorio(void) {
+#if PERFIL_ATIVO
+  printf("%-12s %8s %8s %8s %8s  (%lu ciclos/us)\n", "etapa", "execs", "min", "med", "max",
+         (unsigned long)hal_ciclos_por_us());
+  for (perfil_etapa_t *e = etapas; e; e = e->proxima) {
+    if (e->geracao != geracao || !e->execucoes)
+      continue;
+    printf("%-12s %8lu %8lu %8lu %8lu\n ", e->nome, (unsigned long)e->execucoes, (unsigned long)e->min,
+           (unsigned long)(e->soma / e->execucoes), (unsigned long)e->max);
+    for (uint8_t i = 0; i < PERFIL_BALDES; ++i)
+      if (e->histograma[i])
+        printf(" 2^%u:%lu", i, (unsigned long)e->histograma[i]);
+    printf("\n");
+  }
+#else
+  printf("Perfil desligado (compile com -DGARDEN_PERFIL=ON)\n");
+#endif
+}
+
+void perfil_zerar(void) {
+  geracao = geracao + 1;
+}
@@ -0,0 +1,48 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include "hal.h"
+
+// Medição por etapa em ciclos (SysTick do núcleo no RP2040): mínimo, máximo, média e histograma
+// logarítmico (balde i = durações de 2^i a 2^(i+1) - 1 ciclos), com RAM fixa por etapa. Cada etapa
+// deve ser medida sempre pelo mesmo núcleo. Com PERFIL_ATIVO = 0 (padrão; -DGARDEN_PERFIL=ON no
+// CMake liga) as macros não geram código nem ocupam RAM.
+//
+//   PERFIL_ETAPA(perfil_envio, "envio");      // Escopo de arquivo
+//   PERFIL_REGISTRAR(perfil_envio);           // Na inicialização, antes de lançar o núcleo 1
+//   PERFIL_INICIO(perfil_envio); ...; PERFIL_FIM(perfil_envio);
+
+#ifndef PERFIL_ATIVO
+#define PERFIL_ATIVO 0
+#endif
+
+#define PERFIL_BALDES 24 // O SysTick tem 24 bits: ~134 ms a 125 MHz
+
+typedef struct perfil_etapa {
+  const char *nome;
+  uint32_t execucoes;
+  uint32_t min, max;
+  uint64_t soma;
+  uint32_t histograma[PERFIL_BALDES];
+  uint32_t geracao; // Estatísticas zeradas por perfil_zerar quando diferente da geração atual
+  struct perfil_etapa *proxima;
+} perfil_etapa_t;
+
+#if PERFIL_ATIVO
+#define PERFIL_ETAPA(var, rotulo) static perfil_etapa_t var = {.nome = rotulo}
+#define PERFIL_REGISTRAR(var) perfil_registrar(&var)
+#define PERFIL_INICIO(var) uint32_t var##_inicio = hal_ciclos()
+#define PERFIL_FIM(var) perfil_medir(&var, hal_ciclos_decorridos(var##_inicio))
+#else
+#define PERFIL_ETAPA(var, rotulo) struct perfil_etapa
+#define PERFIL_REGISTRAR(var) ((void)0)
+#define PERFIL_INICIO(var) ((void)0)
+#define PERFIL_FIM(var) ((void)0)
+#endif
+
+void perfil_registrar(perfil_etapa_t *e);
+void perfil_medir(perfil_etapa_t *e, uint32_t ciclos);
+void perfil_relatorio(void);
+void perfil_zerar(void); // Cada etapa é zerada pelo próprio núcleo na próxima medição
+
+#endif
@@ -0,0 +1,61 @@
+#include "quadro.h"
+
+uint16_t quadro_crc16(const uint8_t *dados, size_t total) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < total; ++i) {
+    crc ^= (uint16_t)dados[i] << 8;
+    for (uint8_t b = 0; b < 8; ++b)
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+size_t quadro_montar(uint8_t *dados, size_t n, uint8_t *saida) {
+  uint16_t crc = quadro_crc16(dados, n);
+  dados[n] = crc & 0xFF;
+  dados[n + 1] = crc >> 8;
+  n += 2;
+
+  // COBS: cada bloco começa com a distância até o próximo zero (ou 0xFF para 254 bytes sem zero)
+  size_t o = 0;
+  saida[o++] = 0;
+  size_t codigo = o++;
+  uint8_t distancia = 1;
+  for (size_t i = 0; i < n; ++i) {
+    if (dados[i]) {
+      saida[o++] = dados[i];
+      distancia++;
+    }
+    if (!dados[i] || distancia == 0xFF) {
+      saida[codigo] = distancia;
+      codigo = o++;
+      distancia = 1;
+    }
+  }
+  saida[codigo] = distancia;
+  saida[o++] = 0;
+  return o;
+}
+
+int quadro_abrir(const uint8_t *quadro, size_t total, uint8_t *saida) {
+  size_t i = 0, o = 0;
+  while (i < total) {
+    uint8_t distancia = quadro[i++];
+    if (!distancia || i + distancia - 1 > total)
+      return -1;
+    for (uint8_t k = 1; k < distancia; ++k) {
+      if (!quadro[i])
+        return -1;
+      saida[o++] = quadro[i++];
+    }
+    if (distancia < 0xFF && i < total)
+      saida[o++] = 0;
+  }
+  if (o < 2)
+    return -1;
+  o -= 2;
+  uint16_t crc = quadro_crc16(saida, o);
+  if (saida[o] != (crc & 0xFF) || saida[o + 1] != crc >> 8)
+    return -1;
+  return (int)o;
+}
@@ -0,0 +1,24 @@
+#ifndef QUADRO_H
+#define QUADRO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Quadros binários para a serial: conteúdo + CRC-16/CCITT (little-endian), codificados em COBS
+// (nenhum byte 0x00 dentro do quadro) e delimitados por 0x00 antes e depois. O zero inicial isola o
+// quadro de qualquer texto ou quadro truncado que tenha vindo antes na mesma serial.
+// Usado pelo firmware e pelas ferramentas de host (host/ler_telemetria.c).
+
+#define QUADRO_MAX(n) ((n) + 2 + ((n) + 2) / 254 + 1 + 2) // Tamanho codificado de n bytes de conteúdo
+
+uint16_t quadro_crc16(const uint8_t *dados, size_t total); // Polinômio 0x1021, início 0xFFFF
+
+// Codifica n bytes de conteúdo em saida (QUADRO_MAX(n) bytes); dados precisa de 2 bytes livres no
+// fim para o CRC. Retorna o tamanho do quadro, delimitadores incluídos.
+size_t quadro_montar(uint8_t *dados, size_t n, uint8_t *saida);
+
+// Decodifica um quadro sem os delimitadores para saida (até total bytes) e confere o CRC. Retorna o
+// tamanho do conteúdo ou -1 se o quadro estiver corrompido.
+int quadro_abrir(const uint8_t *quadro, size_t total, uint8_t *saida);
+
+#endif
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include "rede.h"
+
+#define RETRATO_FIXO 11 // Cabeçalho e campos do retrato antes das zonas
+
+// Acumula um byte do barramento. Retorna o tamanho do conteúdo quando um quadro íntegro termina, 0
+// enquanto não termina (ou quadro vazio) e -1 para um quadro corrompido ou longo demais.
+static int receber(rede_rx_t *rx, uint8_t b, uint8_t *conteudo) {
+  if (b) {
+    if (rx->total < sizeof rx->bruto)
+      rx->bruto[rx->total++] = b;
+    else
+      rx->transbordou = true;
+    return 0;
+  }
+  int n = rx->transbordou ? -1 : rx->total ? quadro_abrir(rx->bruto, rx->total, conteudo) : 0;
+  rx->total = 0;
+  rx->transbordou = false;
+  return n;
+}
+
+// Nó ---------------------------------------------------------------------------------------------
+
+void rede_no_init(rede_no_t *no, uint8_t endereco, uint64_t agora_us) {
+  *no = (rede_no_t){.endereco = endereco, .ultima_us = agora_us}; // Depois do boot espera o coordenador por REDE_SILENCIO_MS
+}
+
+bool rede_no_byte(rede_no_t *no, uint8_t b, uint64_t agora_us) {
+  uint8_t m[REDE_QUADRO_MAX];
+  int n = receber(&no->rx, b, m);
+  if (n < 0)
+    ++no->corrompidos;
+  if (n < 4 || m[0] != no->endereco)
+    return false; // Incompleto, corrompido, para outro nó ou resposta de outro nó
+  if (m[1] == REDE_AJUSTE && n == 7) {
+    no->ajuste = true;
+    no->ajuste_zona = m[4];
+    no->ajuste_ideal = m[5];
+    no->ajuste_rega = m[6];
+  } else if (m[1] != REDE_CONSULTA || n != 4) {
+    return false;
+  }
+  no->sequencia = m[2];
+  no->liberado = m[3];
+  no->ultima_us = agora_us;
+  ++no->consultas;
+  return true;
+}
+
+bool rede_no_ajuste(rede_no_t *no, uint8_t *zona, uint8_t *ideal, uint8_t *rega) {
+  if (!no->ajuste)
+    return false;
+  no->ajuste = false;
+  *zona = no->ajuste_zona;
+  *ideal = no->ajuste_ideal;
+  *rega = no->ajuste_rega;
+  return true;
+}
+
+size_t rede_no_responder(rede_no_t *no, const rede_retrato_t *r, uint8_t *saida) {
+  uint8_t m[REDE_CONTEUDO_MAX + 2]; // + CRC
+  uint8_t zonas = r->zonas > ZONAS_MAX ? ZONAS_MAX : r->zonas;
+  size_t n = 0;
+  m[n++] = no->endereco;
+  m[n++] = REDE_RETRATO;
+  m[n++] = no->sequencia;
+  m[n++] = zonas;
+  m[n++] = (uint8_t)r->irrigando;
+  m[n++] = r->pedido;
+  m[n++] = r->alerta;
+  m[n++] = r->falhas & 0xFF;
+  m[n++] = r->falhas >> 8;
+  m[n++] = r->luz;
+  m[n++] = r->regas;
+  for (uint8_t z = 0; z < zonas; ++z) {
+    m[n++] = r->umidade[z];
+    m[n++] = r->ideal[z];
+    m[n++] = r->rega[z];
+  }
+  return quadro_montar(m, n, saida);
+}
+
+bool rede_no_liberado(const rede_no_t *no, uint64_t agora_us) {
+  return no->liberado || agora_us - no->ultima_us >= REDE_SILENCIO_MS * 1000ull;
+}
+
+// Coordenador ------------------------------------------------------------------------------------
+
+void rede_coord_init(rede_coord_t *c, uint8_t nos, uint8_t bombas_max) {
+  *c = (rede_coord_t){
+    .nos = nos > REDE_NOS_MAX ? REDE_NOS_MAX : nos,
+    .bombas_max = bombas_max,
+  };
+  c->atual = c->nos; // O primeiro ciclo começa na primeira chamada de rede_coord_passo
+  for (uint8_t i = 0; i < REDE_NOS_MAX; ++i)
+    c->no[i].retrato.irrigando = -1;
+}
+
+bool rede_coord_ajustar(rede_coord_t *c, uint8_t endereco, uint8_t zona, uint8_t ideal, uint8_t rega) {
+  if (!endereco || endereco > c->nos || zona >= ZONAS_MAX || ideal > REDE_IDEAL_MAX || rega < REDE_REGA_MIN ||
+      rega > REDE_REGA_MAX)
+    return false;
+  rede_no_info_t *info = &c->no[endereco - 1];
+  if (info->resposta_us && zona >= info->retrato.zonas)
+    return false;
+  info->ajuste_ideal[zona] = ideal;
+  info->ajuste_rega[zona] = rega;
+  info->ajustes |= 1u << zona;
+  return true;
+}
+
+bool rede_coord_online(const rede_coord_t *c, uint8_t endereco, uint64_t agora_us) {
+  const rede_no_info_t *info = &c->no[endereco - 1];
+  return info->resposta_us && agora_us - info->resposta_us < REDE_SILENCIO_MS * 1000ull;
+}
+
+uint8_t rede_coord_bombas(const rede_coord_t *c) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < c->nos; ++i)
+    n += c->no[i].liberado || c->no[i].devolvendo;
+  return n;
+}
+
+// No início de cada ciclo: retira a vez já usada, a esquecida e a de quem sumiu, e dá as vagas do
+// orçamento aos pedidos em rodízio
+static void distribuir_vez(rede_coord_t *c, uint64_t agora) {
+  uint8_t em_uso = 0;
+  for (uint8_t i = 0; i < c->nos; ++i) {
+    rede_no_info_t *info = &c->no[i];
+    bool online = rede_coord_online(c, i + 1, agora);
+    bool regando = info->retrato.irrigando >= 0;
+    if (info->liberado && (!online || !regando)) {
+      bool usou = info->retrato.regas != info->regas_na_vez;
+      if (!online || usou || !info->retrato.pedido || agora - info->liberado_us >= REDE_VEZ_MS * 1000ull) {
+        info->liberado = false;
+        info->devolvendo = true;
+      }
+    }
+    if (!online)
+      info->devolvendo = false; // Sozinho (ver rede_no_liberado): fora do orçamento até voltar
+    em_uso += info->liberado || info->devolvendo;
+  }
+  for (uint8_t k = 0; k < c->nos && em_uso < c->bombas_max; ++k) {
+    uint8_t i = (c->vez + k) % c->nos;
+    rede_no_info_t *info = &c->no[i];
+    if (info->liberado || info->devolvendo || !info->retrato.pedido || !rede_coord_online(c, i + 1, agora))
+      continue;
+    info->liberado = true;
+    info->liberado_us = agora;
+    info->regas_na_vez = info->retrato.regas;
+    ++info->vezes;
+    ++em_uso;
+    c->vez = (i + 1) % c->nos;
+  }
+}
+
+// Passa para o próximo nó; depois do último, fecha o ciclo e marca o início do seguinte
+static void proximo(rede_coord_t *c, uint64_t agora) {
+  c->esperando = false;
+  c->prazo_us = agora;
+  if (++c->atual < c->nos)
+    return;
+  c->ciclo_ultimo_us = agora - c->ciclo_inicio_us;
+  if (c->ciclo_ultimo_us > c->ciclo_max_us)
+    c->ciclo_max_us = c->ciclo_ultimo_us;
+  c->ciclo_soma_us += c->ciclo_ultimo_us;
+  ++c->ciclos;
+  c->prazo_us = c->ciclo_inicio_us + REDE_CICLO_MS * 1000ull;
+}
+
+// Consulta ao nó atual, com o primeiro ajuste pendente dele
+static size_t consultar(rede_coord_t *c, uint64_t agora, uint8_t *saida) {
+  rede_no_info_t *info = &c->no[c->atual];
+  uint8_t m[7 + 2]; // + CRC
+  size_t n = 0;
+  m[n++] = c->atual + 1;
+  m[n++] = info->ajustes ? REDE_AJUSTE : REDE_CONSULTA;
+  m[n++] = ++c->sequencia;
+  m[n++] = info->liberado;
+  if (info->ajustes) {
+    uint8_t z = 0;
+    while (!(info->ajustes & (1u << z)))
+      ++z;
+    m[n++] = z;
+    m[n++] = info->ajuste_ideal[z];
+    m[n++] = info->ajuste_rega[z];
+  }
+  c->liberado_enviado = info->liberado;
+  c->esperando = true;
+  c->prazo_us = agora + REDE_RESPOSTA_MS * 1000ull;
+  ++info->consultas;
+  return quadro_montar(m, n, saida);
+}
+
+size_t rede_coord_passo(rede_coord_t *c, uint64_t agora_us, uint8_t *saida) {
+  if (!c->nos || agora_us < c->prazo_us)
+    return 0;
+  if (c->esperando) {
+    ++c->no[c->atual].sem_resposta;
+    proximo(c, agora_us);
+    if (agora_us < c->prazo_us)
+      return 0; // Era o último nó: o próximo ciclo ainda não começou
+  }
+  if (c->atual >= c->nos) {
+    c->atual = 0;
+    c->ciclo_inicio_us = agora_us;
+    distribuir_vez(c, agora_us);
+  }
+  return consultar(c, agora_us, saida);
+}
+
+uint64_t rede_coord_prazo(const rede_coord_t *c) {
+  return c->prazo_us;
+}
+
+// Resposta do nó consultado: com outra sequência ou de outro endereço é um atraso de um ciclo
+// anterior e é ignorada
+void rede_coord_byte(rede_coord_t *c, uint8_t b, uint64_t agora_us) {
+  uint8_t m[REDE_QUADRO_MAX];
+  int n = receber(&c->rx, b, m);
+  if (n < 0)
+    ++c->corrompidos;
+  if (!c->esperando || n < RETRATO_FIXO || m[0] != c->atual + 1 || m[1] != REDE_RETRATO || m[2] != c->sequencia ||
+      m[3] > ZONAS_MAX || n != RETRATO_FIXO + 3 * m[3])
+    return;
+  rede_no_info_t *info = &c->no[c->atual];
+  rede_retrato_t *r = &info->retrato;
+  r->zonas = m[3];
+  r->irrigando = (int8_t)m[4];
+  r->pedido = m[5];
+  r->alerta = m[6];
+  r->falhas = m[7] | m[8] << 8;
+  r->luz = m[9];
+  r->regas = m[10];
+  for (uint8_t z = 0; z < r->zonas; ++z) {
+    r->umidade[z] = m[RETRATO_FIXO + 3 * z];
+    r->ideal[z] = m[RETRATO_FIXO + 3 * z + 1];
+    r->rega[z] = m[RETRATO_FIXO + 3 * z + 2];
+  }
+  for (uint8_t z = 0; z < ZONAS_MAX; ++z) // Confirmados pelo retrato (ou zona que o nó não tem)
+    if (z >= r->zonas || (r->ideal[z] == info->ajuste_ideal[z] && r->rega[z] == info->ajuste_rega[z]))
+      info->ajustes &= ~(1u << z);
+  if (!c->liberado_enviado && r->irrigando < 0)
+    info->devolvendo = false; // O nó já sabe que está sem a vez e não está regando
+  info->resposta_us = agora_us;
+  ++info->respostas;
+  proximo(c, agora_us);
+}
+
+void rede_coord_relatorio(const rede_coord_t *c, uint64_t agora_us) {
+  printf("Rede: %u nós, %lu ciclos de %lu.%lu ms em média (máx %lu.%lu ms), %lu quadros corrompidos, %u/%u vezes em uso\n",
+         c->nos, (unsigned long)c->ciclos, (unsigned long)(c->ciclos ? c->ciclo_soma_us / c->ciclos / 1000 : 0),
+         (unsigned long)(c->ciclos ? c->ciclo_soma_us / c->ciclos / 100 % 10 : 0), (unsigned long)(c->ciclo_max_us / 1000),
+         (unsigned long)(c->ciclo_max_us / 100 % 10), (unsigned long)c->corrompidos, rede_coord_bombas(c), c->bombas_max);
+  for (uint8_t i = 0; i < c->nos; ++i) {
+    const rede_no_info_t *info = &c->no[i];
+    const rede_retrato_t *r = &info->retrato;
+    printf("  nó %u: %s, %lu/%lu respostas, %lu vezes, %s", i + 1, rede_coord_online(c, i + 1, agora_us) ? "online" : "sem resposta",
+           (unsigned long)info->respostas, (unsigned long)info->consultas, (unsigned long)info->vezes,
+           r->irrigando >= 0 ? "regando" : info->liberado ? "com a vez" : r->pedido ? "esperando a vez" : "ocioso");
+    for (uint8_t z = 0; z < r->zonas; ++z) {
+      if (r->umidade[z] == REDE_SEM_LEITURA)
+        printf(z ? ", -" : ": umidade -");
+      else
+        printf(z ? ", %u%%" : ": umidade %u%%", r->umidade[z]);
+    }
+    for (uint8_t z = 0; z < ZONAS_MAX; ++z)
+      if (info->ajustes & 1u << z)
+        printf(" (ajuste da zona %u: ideal %u%%, rega %u s, a confirmar)", z + 1, info->ajuste_ideal[z], info->ajuste_rega[z]);
+    printf("\n");
+  }
+}
@@ -0,0 +1,123 @@
+#ifndef REDE_H
+#define REDE_H
+
+#include "hal.h"
+#include "zonas.h"
+#include "quadro.h"
+
+// Rede de várias placas em um barramento RS-485 (UART com transceptor half-duplex). Um coordenador
+// consulta os nós um a um e só o nó consultado responde, então nunca há dois transmissores ao mesmo
+// tempo. Cada mensagem é um quadro de quadro.h (COBS + CRC-16) com o conteúdo
+//   [endereço][tipo][sequência] dados...
+// Todos os nós recebem todos os quadros e ignoram os que não são consultas ao seu endereço.
+//
+// Consulta: diz ao nó se ele tem a vez da bomba. Ajuste: o mesmo, mais a umidade ideal e o tempo de
+// rega de uma zona. O nó responde às duas com o seu retrato (zonas, rega, pedido, alerta, defeitos).
+// O coordenador repete o ajuste a cada ciclo até o retrato mostrar os valores novos, e uma resposta
+// perdida só custa um ciclo.
+//
+// Vez da bomba: as placas dividem um orçamento de no máximo bombas_max bombas ligadas ao mesmo tempo
+// (água do mesmo reservatório, corrente da mesma fonte). A vez é dada em rodízio aos nós com pedido
+// e vale para uma rega. Retirada, ela só deixa de contar no orçamento quando o nó responde a uma
+// consulta sem a vez e sem estar regando, então o orçamento vale mesmo com quadros perdidos. Um nó
+// sem consultas por REDE_SILENCIO_MS volta a regar sozinho: um coordenador parado ou um cabo solto
+// não podem secar o jardim (esse nó sai do orçamento até voltar a responder).
+
+#define REDE_BAUD 115200
+#define REDE_NOS_MAX 32 // Endereços 1 a REDE_NOS_MAX; 0 = sem rede
+#define REDE_CONTEUDO_MAX (11 + 3 * ZONAS_MAX) // Retrato com todas as zonas
+#define REDE_QUADRO_MAX QUADRO_MAX(REDE_CONTEUDO_MAX)
+#define REDE_RESPOSTA_MS 20 // Espera do coordenador pela resposta, contando o envio da consulta
+#define REDE_CICLO_MS 500 // Intervalo mínimo entre o início de dois ciclos de consultas
+#define REDE_VEZ_MS 15000 // Vez dada e não usada por este tempo volta para o rodízio
+#define REDE_SILENCIO_MS 10000 // Sem consultas por este tempo o nó rega sozinho
+
+#define REDE_IDEAL_MAX 100 // Mesmos limites dos botões (jardim.c)
+#define REDE_REGA_MIN 5
+#define REDE_REGA_MAX 40
+
+#define REDE_SEM_LEITURA 0xFF // Umidade de uma zona sem leitura ou com o sensor com defeito
+
+typedef enum {
+  REDE_CONSULTA = 1, // [vez]
+  REDE_AJUSTE = 2, // [vez][zona][ideal][rega]
+  REDE_RETRATO = 0x81 // Resposta de um nó: [zonas][irrigando][pedido][alerta][falhas, 2][luz][regas] e, por zona, [umidade][ideal][rega]
+} rede_tipo_t;
+
+// Retrato de um nó, como vai no quadro
+typedef struct {
+  uint8_t zonas;
+  int8_t irrigando; // Zona com o relé ligado (-1 = nenhuma)
+  bool pedido; // Alguma zona com sede esperando a vez
+  uint8_t alerta; // alerta_t (estado.h)
+  uint16_t falhas; // Bits como em estado_t
+  uint8_t luz; // %
+  uint8_t regas; // Regas desde o boot (volta em 255): o coordenador vê que a vez foi usada
+  uint8_t umidade[ZONAS_MAX]; // % ou REDE_SEM_LEITURA
+  uint8_t ideal[ZONAS_MAX], rega[ZONAS_MAX]; // %, s
+} rede_retrato_t;
+
+// Quadro em recepção, byte a byte até o delimitador
+typedef struct {
+  uint8_t bruto[REDE_QUADRO_MAX];
+  uint8_t total;
+  bool transbordou;
+} rede_rx_t;
+
+// Ponta do nó
+typedef struct {
+  uint8_t endereco;
+  rede_rx_t rx;
+  uint8_t sequencia; // Da última consulta, repetida na resposta
+  bool liberado; // Vez dada na última consulta
+  uint64_t ultima_us; // Última consulta a este nó (ou o boot)
+  bool ajuste; // Ajuste recebido e ainda não lido
+  uint8_t ajuste_zona, ajuste_ideal, ajuste_rega;
+  uint32_t consultas, corrompidos;
+} rede_no_t;
+
+void rede_no_init(rede_no_t *no, uint8_t endereco, uint64_t agora_us);
+bool rede_no_byte(rede_no_t *no, uint8_t b, uint64_t agora_us); // true: consulta a este nó, responder já
+bool rede_no_ajuste(rede_no_t *no, uint8_t *zona, uint8_t *ideal, uint8_t *rega); // Ajuste da última consulta (uma vez)
+size_t rede_no_responder(rede_no_t *no, const rede_retrato_t *r, uint8_t *saida); // saida: REDE_QUADRO_MAX bytes
+bool rede_no_liberado(const rede_no_t *no, uint64_t agora_us); // Com a vez ou sozinho por falta de consultas
+
+// Ponta do coordenador: o que ele sabe de cada nó
+typedef struct {
+  rede_retrato_t retrato;
+  uint64_t resposta_us; // Última resposta íntegra (0 = nunca)
+  bool liberado; // Tem a vez
+  bool devolvendo; // Vez retirada e ainda não confirmada pelo nó: continua no orçamento
+  uint64_t liberado_us;
+  uint8_t regas_na_vez; // retrato.regas quando recebeu a vez
+  uint8_t ajustes; // Bit z: ajuste da zona z a confirmar
+  uint8_t ajuste_ideal[ZONAS_MAX], ajuste_rega[ZONAS_MAX];
+  uint32_t consultas, respostas, sem_resposta, vezes;
+} rede_no_info_t;
+
+typedef struct {
+  uint8_t nos; // Nós consultados: endereços 1 a nos
+  uint8_t bombas_max;
+  rede_no_info_t no[REDE_NOS_MAX];
+  rede_rx_t rx;
+  uint8_t atual; // Índice do nó consultado; nos = ciclo terminado
+  uint8_t sequencia;
+  bool esperando, liberado_enviado;
+  uint64_t prazo_us; // Fim da espera pela resposta ou início do próximo ciclo
+  uint64_t ciclo_inicio_us;
+  uint8_t vez; // Início do rodízio na próxima vez dada
+  uint32_t ciclos, corrompidos;
+  uint64_t ciclo_soma_us;
+  uint32_t ciclo_ultimo_us, ciclo_max_us; // Do início da primeira consulta ao fim da última resposta
+} rede_coord_t;
+
+void rede_coord_init(rede_coord_t *c, uint8_t nos, uint8_t bombas_max);
+bool rede_coord_ajustar(rede_coord_t *c, uint8_t endereco, uint8_t zona, uint8_t ideal, uint8_t rega); // false fora dos limites dos botões
+size_t rede_coord_passo(rede_coord_t *c, uint64_t agora_us, uint8_t *saida); // Próxima consulta (0 = nada agora); saida: REDE_QUADRO_MAX
+uint64_t rede_coord_prazo(const rede_coord_t *c); // Próxima chamada de rede_coord_passo se nada chegar
+void rede_coord_byte(rede_coord_t *c, uint8_t b, uint64_t agora_us);
+bool rede_coord_online(const rede_coord_t *c, uint8_t endereco, uint64_t agora_us);
+uint8_t rede_coord_bombas(const rede_coord_t *c); // Vezes no orçamento (dadas ou a confirmar)
+void rede_coord_relatorio(const rede_coord_t *c, uint64_t agora_us);
+
+#endif
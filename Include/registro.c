@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <string.h>
+#include "registro.h"
+
+#define PAGINAS_POR_SETOR (HAL_FLASH_SETOR / HAL_FLASH_PAGINA)
+
+typedef struct {
+  uint8_t dados[HAL_FLASH_PAGINA];
+  uint16_t uso; // Bytes ocupados
+  uint16_t gravado; // Bytes já gravados na flash (sincronia de página parcial)
+  uint32_t sequencia; // Setor a que a página pertence
+  uint8_t pagina; // Índice da página dentro do setor
+  bool valida;
+} pagina_t;
+
+static pagina_t atual, pendente; // Página em composição e página completa aguardando gravação
+static uint32_t apagado; // Sequência do último setor apagado (pronto para gravação)
+static uint16_t boot;
+static registro_amostra_t anterior; // Referência dos deltas de tempo e luz
+static uint16_t umidade_anterior[ZONAS_MAX]; // Referência dos deltas de umidade, por zona
+static uint32_t perdidas;
+static uint64_t ultima_sincronia_us;
+static bool sincronia_forcada;
+
+static uint32_t endereco_setor(uint32_t sequencia) {
+  return REGISTRO_INICIO + (sequencia % REGISTRO_SETORES) * HAL_FLASH_SETOR;
+}
+
+static const registro_cabecalho_t *cabecalho(uint8_t setor) {
+  const registro_cabecalho_t *c = (const registro_cabecalho_t *)hal_flash_ler(REGISTRO_INICIO + setor * HAL_FLASH_SETOR);
+  return c->magico == REGISTRO_MAGICO && c->versao >= 1 && c->versao <= REGISTRO_VERSAO ? c : NULL;
+}
+
+static uint8_t varint(uint8_t *p, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    p[n++] = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  p[n++] = v;
+  return n;
+}
+
+// Zigzag: diferenças pequenas, positivas ou negativas, viram inteiros pequenos (0, -1, 1, -2... -> 0, 1, 2, 3...)
+static uint8_t varint_sinal(uint8_t *p, int32_t v) {
+  return varint(p, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+// Começa uma página vazia; a primeira de cada setor leva o cabeçalho e zera a referência dos deltas
+static void nova_pagina(uint32_t sequencia, uint8_t pagina) {
+  memset(atual.dados, 0xFF, sizeof atual.dados);
+  atual.uso = atual.gravado = 0;
+  atual.sequencia = sequencia;
+  atual.pagina = pagina;
+  atual.valida = true;
+  if (pagina == 0) {
+    registro_cabecalho_t c = {REGISTRO_MAGICO, sequencia, boot, REGISTRO_VERSAO, anterior.t};
+    memcpy(atual.dados, &c, sizeof c);
+    atual.uso = sizeof c;
+    anterior.luz = 0;
+    memset(umidade_anterior, 0, sizeof umidade_anterior);
+  }
+}
+
+void registro_init(void) {
+  uint32_t maior = 0;
+  for (uint8_t s = 0; s < REGISTRO_SETORES; ++s) {
+    const registro_cabecalho_t *c = cabecalho(s);
+    if (!c)
+      continue;
+    if (c->sequencia > maior)
+      maior = c->sequencia;
+    if (c->boot >= boot)
+      boot = c->boot + 1;
+  }
+  apagado = maior; // O setor seguinte ainda precisa ser apagado
+  anterior = (registro_amostra_t){.t = hal_tempo_us() / 100000};
+  nova_pagina(maior + 1, 0);
+}
+
+bool registro_adicionar(const registro_amostra_t *a) {
+  uint8_t buf[16];
+  for (int tentativa = 0; tentativa < 2; ++tentativa) {
+    uint8_t n = 0;
+    uint8_t z = a->zona & 7;
+    buf[n++] = (a->rele ? 1 : 0) | ((a->alerta & 7) << 1) | (z << 4);
+    n += varint(&buf[n], a->t - anterior.t);
+    n += varint_sinal(&buf[n], (int32_t)a->luz - anterior.luz);
+    n += varint_sinal(&buf[n], (int32_t)a->umidade - umidade_anterior[z]);
+    if (atual.uso + n <= HAL_FLASH_PAGINA) {
+      memcpy(&atual.dados[atual.uso], buf, n);
+      atual.uso += n;
+      anterior = *a;
+      umidade_anterior[z] = a->umidade;
+      return true;
+    }
+    // Página cheia: passa para a fila de gravação e recodifica na próxima (os deltas podem ter zerado)
+    if (pendente.valida)
+      break;
+    pendente = atual;
+    if (atual.pagina + 1u < PAGINAS_POR_SETOR)
+      nova_pagina(atual.sequencia, atual.pagina + 1);
+    else
+      nova_pagina(atual.sequencia + 1, 0);
+  }
+  perdidas++;
+  return false;
+}
+
+static void gravar(pagina_t *p) {
+  hal_flash_programar(endereco_setor(p->sequencia) + p->pagina * HAL_FLASH_PAGINA, p->dados);
+  p->gravado = p->uso;
+}
+
+// Uma operação por chamada: o apagamento (dezenas de ms) e cada gravação de página (~1 ms) param
+// a flash, então ficam espalhados entre os passos da interface
+bool registro_executar(void) {
+  pagina_t *p = pendente.valida ? &pendente : &atual;
+  if (p->sequencia > apagado) {
+    // Apaga o setor mais antigo do anel só quando a primeira página dele fica pronta para gravar
+    if (p == &atual && atual.uso == sizeof(registro_cabecalho_t) && !pendente.valida)
+      return false; // Setor novo sem nenhum registro ainda
+    hal_flash_apagar(endereco_setor(p->sequencia));
+    apagado = p->sequencia;
+    return true;
+  }
+  if (pendente.valida) {
+    gravar(&pendente);
+    pendente.valida = false;
+    return true;
+  }
+  uint64_t agora = hal_tempo_us();
+  if (atual.uso > atual.gravado && (sincronia_forcada || agora - ultima_sincronia_us >= REGISTRO_SINCRONIA_MS * 1000ull)) {
+    // Regrava a página parcial: bytes já gravados não mudam e os novos só levam bits de 1 para 0
+    gravar(&atual);
+    ultima_sincronia_us = agora;
+    return true;
+  }
+  return false;
+}
+
+void registro_sincronizar(void) {
+  sincronia_forcada = true;
+  for (int i = 0; i < 4 && (pendente.valida || atual.uso > atual.gravado); ++i)
+    registro_executar(); // Apagamento, página pendente e página parcial, nessa ordem
+  sincronia_forcada = false;
+}
+
+// Exportação: linha "REGISTRO <versão>", depois, para cada setor válido do mais antigo ao mais
+// recente, um byte com o número de páginas usadas seguido das páginas; um byte 0 e "FIM" encerram
+void registro_exportar(void) {
+  registro_sincronizar();
+  printf("REGISTRO %d\n", REGISTRO_VERSAO);
+  uint8_t mais_novo = 0;
+  uint32_t maior = 0;
+  for (uint8_t s = 0; s < REGISTRO_SETORES; ++s) {
+    const registro_cabecalho_t *c = cabecalho(s);
+    if (c && c->sequencia > maior) {
+      maior = c->sequencia;
+      mais_novo = s;
+    }
+  }
+  for (uint16_t i = 1; i <= REGISTRO_SETORES; ++i) {
+    uint8_t s = (mais_novo + i) % REGISTRO_SETORES;
+    if (!cabecalho(s))
+      continue;
+    const uint8_t *setor = hal_flash_ler(REGISTRO_INICIO + s * HAL_FLASH_SETOR);
+    uint8_t paginas = 1;
+    while (paginas < PAGINAS_POR_SETOR && setor[paginas * HAL_FLASH_PAGINA] != 0xFF)
+      paginas++;
+    hal_serial_escrever_bruto(&paginas, 1);
+    hal_serial_escrever_bruto(setor, paginas * HAL_FLASH_PAGINA);
+  }
+  uint8_t fim = 0;
+  hal_serial_escrever_bruto(&fim, 1);
+  printf("FIM\n");
+}
+
+uint32_t registro_perdidas(void) {
+  return perdidas;
+}
@@ -0,0 +1,61 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include "hal.h"
+#include "zonas.h"
+
+// Histórico dos sensores na flash: anel de setores no fim da flash, apagados em sequência (cada
+// setor é apagado uma vez por volta do anel). As amostras são codificadas em RAM, página a página,
+// e gravadas por registro_executar, no máximo uma operação de flash por chamada.
+//
+// Setor: cabeçalho de 16 bytes + registros. Um registro nunca atravessa páginas; o restante de
+// uma página fica em 0xFF, e 0xFF no início de um registro marca o fim dos dados da página.
+// Registro: [cab][varint dt][zigzag varint dluz][zigzag varint dumidade]
+//   cab: bit 0 = relé da zona, bits 1-3 = alerta (alerta_t), bits 4-6 = zona, bit 7 sempre 0
+//   dt em décimos de segundo desde o registro anterior (o primeiro do setor parte de t0)
+//   dluz: diferença da leitura do ADC para o registro anterior; dumidade: para o registro anterior
+//   da mesma zona (as referências começam em 0 em cada setor)
+// A versão 1 (uma zona só) tem o mesmo formato com a zona sempre 0 e continua legível.
+// Cada boot começa um setor novo, então os tempos (desde o boot) nunca voltam dentro de um setor.
+//
+// As gravações rodam no núcleo 1. Enquanto duram, o núcleo 0 espera na RAM (hal_flash_pausavel):
+// o alarme que desliga o relé dispara no horário, mas o laço de controle fica parado. Por isso o
+// núcleo 1 faz no máximo uma operação por passo, entre o histórico e os ajustes (ajustes.c), e
+// nenhuma com um relé ligado: as gravações esperam o fim da rega (no máximo 40 s), e o corte por
+// falta de vazão (agua.c) e a boia nunca ficam parados com a bomba ligada. Sem rega, o laço de
+// controle para por uma operação: ~45 ms típicos num apagamento, até 400 ms no tempo máximo da
+// flash. A exportação (comando "D") sincroniza tudo de uma vez e pode somar um apagamento e duas
+// gravações. Os bytes da rede que passarem dos 32 do FIFO da UART nesse tempo se perdem, e o
+// coordenador repete a consulta.
+
+#define REGISTRO_SETORES 128 // 512 KB no fim da flash
+#define REGISTRO_INICIO (PICO_FLASH_SIZE_BYTES - REGISTRO_SETORES * HAL_FLASH_SETOR)
+#define REGISTRO_MAGICO 0x474F4C47u // "GLOG"
+#define REGISTRO_VERSAO 2
+#define REGISTRO_INTERVALO_MS 60000 // Amostra periódica; mudanças de relé e alerta são registradas na hora
+#define REGISTRO_SINCRONIA_MS 600000 // Página parcial regravada no máximo a cada 10 min
+
+typedef struct {
+  uint32_t magico;
+  uint32_t sequencia; // Ordem dos setores no anel (o maior é o mais recente)
+  uint16_t boot; // Contador de inicializações
+  uint16_t versao;
+  uint32_t t0; // Tempo desde o boot no início do setor (décimos de segundo)
+} registro_cabecalho_t;
+
+typedef struct {
+  uint32_t t; // Décimos de segundo desde o boot
+  uint8_t zona;
+  uint16_t luz, umidade; // Leituras do ADC (12 bits; umidade = ZONA_SEM_LEITURA sem leitura)
+  bool rele;
+  uint8_t alerta;
+} registro_amostra_t;
+
+void registro_init(void);
+bool registro_adicionar(const registro_amostra_t *a); // false se a RAM estiver cheia (amostra perdida)
+bool registro_executar(void); // Uma gravação ou apagamento pendente, se houver (true se houve)
+void registro_sincronizar(void); // Grava tudo que está em RAM
+void registro_exportar(void); // Envia o histórico inteiro pela serial (formato em registro.c)
+uint32_t registro_perdidas(void);
+
+#endif
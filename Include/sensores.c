@@ -0,0 +1,94 @@
+#include "sensores.h"
+
+#define RING_AMOSTRAS ((1u << SENSORES_RING_BITS) / sizeof(uint16_t))
+
+// Buffer circular preenchido continuamente pela DMA. O round-robin começa no canal 0 e o tamanho é
+// múltiplo do número de canais, então a amostra i pertence sempre ao canal i % SENSORES_CANAIS.
+// O round-robin percorre as entradas em ordem crescente: 0, 1, 2 e 4 (temperatura) ocupam os canais 0 a 3.
+static uint16_t ring[RING_AMOSTRAS] __attribute__((aligned(1u << SENSORES_RING_BITS)));
+
+static int dma_amostras; // Canal que copia o FIFO do ADC para o buffer circular
+static int dma_rearme; // Canal que recarrega a contagem do primeiro ao final de cada volta
+static const uint32_t contagem = RING_AMOSTRAS;
+
+static uint8_t oversampling[SENSORES_CANAIS];
+
+void sensores_init(void) {
+  adc_init();
+  for (uint8_t canal = 0; canal < SENSORES_CANAIS; ++canal) {
+    if (canal != SENSOR_CANAL_TEMPERATURA)
+      adc_gpio_init(26 + canal);
+    oversampling[canal] = 4; // 16 amostras por padrão
+  }
+  adc_set_temp_sensor_enabled(true);
+
+  adc_select_input(0);
+  adc_set_round_robin(0x17); // Entradas 0, 1, 2 e 4
+  adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits sem deslocamento
+  adc_set_clkdiv(48000000.0f / SENSORES_TAXA_HZ - 1);
+
+  dma_amostras = dma_claim_unused_channel(true);
+  dma_rearme = dma_claim_unused_channel(true);
+
+  dma_channel_config c = dma_channel_get_default_config(dma_amostras);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, SENSORES_RING_BITS);
+  channel_config_set_dreq(&c, DREQ_ADC);
+  channel_config_set_chain_to(&c, dma_rearme);
+  dma_channel_configure(dma_amostras, &c, ring, &adc_hw->fifo, RING_AMOSTRAS, false);
+
+  // Ao terminar uma volta, o segundo canal reescreve a contagem (com gatilho) e a aquisição nunca para
+  dma_channel_config r = dma_channel_get_default_config(dma_rearme);
+  channel_config_set_transfer_data_size(&r, DMA_SIZE_32);
+  channel_config_set_read_increment(&r, false);
+  channel_config_set_write_increment(&r, false);
+  dma_channel_configure(dma_rearme, &r, &dma_channel_hw_addr(dma_amostras)->al1_transfer_count_trig,
+                        &contagem, 1, false);
+
+  dma_channel_start(dma_amostras);
+  adc_run(true);
+
+  // Aguarda amostras suficientes para o maior oversampling, evitando que o controle decida sobre zeros
+  while (dma_channel_hw_addr(dma_amostras)->transfer_count > RING_AMOSTRAS - (SENSORES_CANAIS << SENSORES_OVERSAMPLING_MAX))
+    tight_loop_contents();
+}
+
+// Média de 2^log2_amostras leituras por canal (limitada a SENSORES_OVERSAMPLING_MAX)
+void sensores_set_oversampling(uint8_t canal, uint8_t log2_amostras) {
+  if (canal >= SENSORES_CANAIS)
+    return;
+  oversampling[canal] = log2_amostras > SENSORES_OVERSAMPLING_MAX ? SENSORES_OVERSAMPLING_MAX : log2_amostras;
+}
+
+// Índice da próxima posição que a DMA vai escrever
+static inline uint32_t posicao_escrita(void) {
+  uintptr_t endereco = dma_channel_hw_addr(dma_amostras)->write_addr;
+  return ((endereco - (uintptr_t)ring) / sizeof(uint16_t)) & (RING_AMOSTRAS - 1);
+}
+
+// Última amostra completa do canal, sem filtragem
+uint16_t sensores_ler_bruto(uint8_t canal) {
+  uint32_t i = posicao_escrita();
+  do {
+    i = (i - 1) & (RING_AMOSTRAS - 1);
+  } while (i % SENSORES_CANAIS != canal);
+  return ring[i];
+}
+
+// Valor filtrado do canal: média das últimas 2^oversampling amostras já convertidas (12 bits)
+uint16_t sensores_ler(uint8_t canal) {
+  uint32_t i = posicao_escrita();
+  do {
+    i = (i - 1) & (RING_AMOSTRAS - 1);
+  } while (i % SENSORES_CANAIS != canal);
+
+  uint8_t shift = oversampling[canal];
+  uint32_t soma = 0;
+  for (uint16_t n = 1u << shift; n; --n) {
+    soma += ring[i];
+    i = (i - SENSORES_CANAIS) & (RING_AMOSTRAS - 1);
+  }
+  return soma >> shift;
+}
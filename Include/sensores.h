@@ -0,0 +1,19 @@
+#ifndef SENSORES_H
+#define SENSORES_H
+
+#include "hal.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+// Aquisição do RP2040 por trás de hal_adc_ler: canais (SENSOR_CANAL_*) amostrados em round-robin
+
+#define SENSORES_TAXA_HZ 4000 // Taxa total de conversão (dividida entre os canais: 1 kHz cada)
+#define SENSORES_RING_BITS 10 // Buffer circular de 2^10 bytes = 512 amostras de 16 bits
+#define SENSORES_OVERSAMPLING_MAX 6 // Até 2^6 = 64 amostras por canal na média
+
+void sensores_init(void);
+void sensores_set_oversampling(uint8_t canal, uint8_t log2_amostras);
+uint16_t sensores_ler(uint8_t canal);
+uint16_t sensores_ler_bruto(uint8_t canal);
+
+#endif
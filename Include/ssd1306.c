@@ -1,5 +1,5 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -7,102 +7,272 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-  ssd->ram_buffer[0] = 0x40;
+  ssd->bufsize = ssd->pages * ssd->width;
+  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t)); // Alinhado a palavra: permite preenchimentos de 32 bits
   ssd->port_buffer[0] = 0x80;
+
+  // Pior caso do envio assíncrono: todas as páginas sujas, cada uma com 13 bytes de comando + uma coluna inteira
+  ssd->dma_buffer = calloc(ssd->pages * (13 + ssd->width), sizeof(uint16_t));
+
+  ssd1306_invalidate(ssd);
+}
+
+// Marca a tela inteira como alterada, forçando o próximo envio a transmitir o quadro completo
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    ssd->dirty_min[page] = 0;
+    ssd->dirty_max[page] = ssd->width - 1;
+  }
+}
+
+static inline void ssd1306_mark_dirty_span(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1) {
+  if (x0 < ssd->dirty_min[page])
+    ssd->dirty_min[page] = x0;
+  if (x1 > ssd->dirty_max[page])
+    ssd->dirty_max[page] = x1;
+}
+
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x, uint8_t page) {
+  ssd1306_mark_dirty_span(ssd, page, x, x);
 }
 
+// Marca como alteradas as colunas x0..x1 das páginas que contêm as linhas y0..y1 (regiões vindas de
+// quem escreve direto em ram_buffer, como o painel)
+void ssd1306_mark_region(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+  for (uint8_t page = y0 >> 3; page <= y1 >> 3; ++page)
+    ssd1306_mark_dirty_span(ssd, page, x0, x1);
+}
+
+// Sequência de inicialização (comandos e argumentos), enviada em uma única transação I2C. O display
+// fica desligado: quem usa liga (SET_DISP | 0x01) depois do primeiro quadro, para não mostrar o
+// conteúdo aleatório da memória dele na partida.
+static const uint8_t ssd1306_init_sequence[] = {
+  SET_DISP | 0x00,
+  SET_MEM_ADDR, 0x01,
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+};
+
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd1306_command_list(ssd, ssd1306_init_sequence, sizeof ssd1306_init_sequence);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd); // A escrita bloqueante reconfigura o periférico e abortaria um envio em andamento
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  hal_i2c_escrever(ssd->i2c_port, ssd->address, ssd->port_buffer, 2);
+}
+
+// Vários comandos (com os argumentos) em uma transação: byte de controle 0x00 (Co = 0, D/C = 0)
+// e a lista inteira em seguida, em vez de uma transação de 2 bytes por comando
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[1 + SSD1306_COMMAND_LIST_MAX];
+  if (count > SSD1306_COMMAND_LIST_MAX)
+    count = SSD1306_COMMAND_LIST_MAX;
+  buffer[0] = 0x00;
+  memcpy(&buffer[1], commands, count);
+  ssd1306_wait(ssd);
+  hal_i2c_escrever(ssd->i2c_port, ssd->address, buffer, count + 1);
 }
 
+// Envio bloqueante: transmite as regiões alteradas e aguarda o fim da transferência
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_wait(ssd);
+  ssd1306_send_data_async(ssd);
+  ssd1306_wait(ssd);
+}
+
+// Inicia, via DMA, o envio apenas das colunas alteradas de cada página. Cada página suja vira uma
+// transação I2C própria (janela de coluna/página + dados), todas encadeadas em um único buffer.
+// Retorna false se ainda houver um envio anterior em andamento.
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+  if (ssd1306_busy(ssd))
+    return false;
+
+  uint16_t *out = ssd->dma_buffer;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    uint8_t x0 = ssd->dirty_min[page];
+    uint8_t x1 = ssd->dirty_max[page];
+    if (x0 > x1)
+      continue;
+
+    // Byte de controle 0x80 = um comando a seguir; 0x40 = restante da transação são dados
+    *out++ = 0x80; *out++ = SET_COL_ADDR;
+    *out++ = 0x80; *out++ = x0;
+    *out++ = 0x80; *out++ = x1;
+    *out++ = 0x80; *out++ = SET_PAGE_ADDR;
+    *out++ = 0x80; *out++ = page;
+    *out++ = 0x80; *out++ = page;
+    *out++ = 0x40;
+    // Endereçamento vertical: a página é o índice mais rápido em ram_buffer
+    const uint8_t *column = &ssd->ram_buffer[page];
+    for (uint16_t x = x0; x <= x1; ++x)
+      *out++ = column[x << 3];
+    out[-1] |= HAL_I2C_STOP;
+
+    ssd->dirty_min[page] = 0xFF;
+    ssd->dirty_max[page] = 0;
+  }
+
+  uint32_t count = out - ssd->dma_buffer;
+  if (count == 0)
+    return true;
+
+  hal_i2c_dma(ssd->i2c_port, ssd->address, ssd->dma_buffer, count);
+  return true;
+}
+
+// Rola uma coluna para a esquerda o trecho x0..x1 das páginas page0..page1; a coluna x1 fica
+// apagada, pronta para o desenho seguinte. Com column_scroll o próprio controlador desloca a memória
+// dele (um comando de 8 bytes) e só a coluna x1 fica para enviar; sem ele a área inteira é marcada.
+// A rolagem contínua (0x26/0x27) não serve aqui: anda no ritmo dos quadros do controlador, não das
+// colunas novas, e a memória precisa ser reescrita depois de desativada.
+void ssd1306_scroll_left(ssd1306_t *ssd, uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1) {
+  if (page1 >= ssd->pages)
+    page1 = ssd->pages - 1;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (page0 > page1 || x0 >= x1)
+    return;
+  uint8_t n = page1 - page0 + 1;
+  uint8_t *ram = &ssd->ram_buffer[page0];
+  for (uint8_t x = x0; x < x1; ++x) // Endereçamento vertical: as páginas de uma coluna são consecutivas
+    memcpy(&ram[x << 3], &ram[(x + 1) << 3], n);
+  memset(&ram[x1 << 3], 0, n);
+
+  if (!ssd->column_scroll) {
+    for (uint8_t page = page0; page <= page1; ++page)
+      ssd1306_mark_dirty_span(ssd, page, x0, x1);
+    return;
+  }
+  // Argumentos: 0x00, página inicial, 0x01, página final, 0x00, coluna inicial, coluna final
+  const uint8_t commands[] = {SET_COLUMN_SCROLL_LEFT, 0x00, page0, 0x01, page1, 0x00, x0, x1};
+  ssd1306_command_list(ssd, commands, sizeof commands); // Espera o envio em andamento terminar
+  for (uint8_t page = page0; page <= page1; ++page) {
+    // Colunas ainda não enviadas andaram junto com as do controlador: a faixa suja anda também.
+    // A coluna x1 recebe no controlador o que saiu pela esquerda e precisa ir de novo.
+    if (ssd->dirty_min[page] > x0 && ssd->dirty_min[page] <= x1 && ssd->dirty_min[page] <= ssd->dirty_max[page])
+      --ssd->dirty_min[page];
+    ssd1306_mark_dirty(ssd, x1, page);
+  }
+}
+
+// Indica se ainda há bytes sendo transferidos
+bool ssd1306_busy(ssd1306_t *ssd) {
+  return hal_i2c_ocupado(ssd->i2c_port);
+}
+
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  uint16_t index = (y >> 3) + (x << 3);
   uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+  uint8_t old = ssd->ram_buffer[index];
+  uint8_t new = value ? (old | (1 << pixel)) : (old & ~(1 << pixel));
+  if (new != old) {
+    ssd->ram_buffer[index] = new;
+    ssd1306_mark_dirty(ssd, x, y >> 3);
+  }
 }
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+// Variante de ssd1306_pixel com verificação de limites: pontos fora da tela são ignorados
+void ssd1306_pixel_clipped(ssd1306_t *ssd, int16_t x, int16_t y, bool value) {
+  if (x < 0 || y < 0 || x >= ssd->width || y >= ssd->height)
+    return;
+  ssd1306_pixel(ssd, x, y, value);
 }
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+// Aplica a máscara de bits nas colunas x0..x1 de uma página. As colunas das pontas que já têm o valor
+// desejado são puladas, de modo que apenas o trecho realmente alterado é marcado como sujo.
+static void ssd1306_page_span(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1, uint8_t mask, bool value) {
+  uint8_t *column = &ssd->ram_buffer[page];
+  uint8_t set = value ? mask : 0;
+  while (x0 <= x1 && (column[x0 << 3] & mask) == set)
+    ++x0;
+  if (x0 > x1)
+    return;
+  while ((column[x1 << 3] & mask) == set)
+    --x1;
+  for (uint8_t *p = &column[x0 << 3], *end = &column[x1 << 3]; p <= end; p += 8)
+    *p = (*p & ~mask) | set;
+  ssd1306_mark_dirty_span(ssd, page, x0, x1);
+}
+
+// Máscara dos bits y0..y1 (inclusive) dentro de uma página de 8 linhas
+static inline uint8_t ssd1306_page_mask(uint8_t y0, uint8_t y1) {
+  return (uint8_t)((0xFFu << (y0 & 7)) & (0xFFu >> (7 - (y1 & 7))));
+}
+
+// Preenche o retângulo [x, x+width) x [y, y+height) página a página, com máscaras nas bordas verticais
+void ssd1306_fill_rect(ssd1306_t *ssd, int16_t x, int16_t y, int16_t width, int16_t height, bool value) {
+  int16_t x1 = x + width - 1;
+  int16_t y1 = y + height - 1;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+  if (y1 >= ssd->height) y1 = ssd->height - 1;
+  if (x > x1 || y > y1)
+    return;
+
+  uint8_t page0 = y >> 3, page1 = y1 >> 3;
+  for (uint8_t page = page0; page <= page1; ++page) {
+    uint8_t top = (page == page0) ? y : 0;
+    uint8_t bottom = (page == page1) ? y1 : 7;
+    ssd1306_page_span(ssd, page, x, x1, ssd1306_page_mask(top, bottom), value);
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  // Percorre o buffer em palavras de 32 bits (4 páginas de uma coluna por palavra), gravando e
+  // marcando como sujas apenas as palavras que realmente mudam
+  uint32_t pattern = value ? 0xFFFFFFFFu : 0;
+  uint32_t *words = (uint32_t *)ssd->ram_buffer;
+  uint16_t count = ssd->bufsize >> 2;
+  for (uint16_t i = 0; i < count; ++i) {
+    uint32_t diff = words[i] ^ pattern;
+    if (!diff)
+      continue;
+    words[i] = pattern;
+    uint8_t x = i >> 1;
+    uint8_t page = (i & 1) << 2;
+    for (; diff; diff >>= 8, ++page) {
+      if (diff & 0xFF)
+        ssd1306_mark_dirty(ssd, x, page);
+    }
   }
+}
 
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    ssd1306_fill_rect(ssd, left, top, width, height, value);
+    return;
   }
+  ssd1306_hline(ssd, left, left + width - 1, top, value);
+  ssd1306_hline(ssd, left, left + width - 1, top + height - 1, value);
+  ssd1306_vline(ssd, left, top, top + height - 1, value);
+  ssd1306_vline(ssd, left + width - 1, top, top + height - 1, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -131,29 +301,125 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
     }
 }
 
+// Linha de 1 pixel: um bit na mesma página de cada coluna, direto em ssd1306_page_span, sem as
+// máscaras de ssd1306_fill_rect. Um byte por coluna, que no M0+ é um ldrb/orrs/strb.
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (x1 < x0 || y >= ssd->height)
+    return;
+  ssd1306_page_span(ssd, y >> 3, x0, x1, 1u << (y & 7), value);
 }
 
+// Linha vertical de 1 pixel: um byte com máscara por página, todos na mesma coluna
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+  if (y1 < y0 || x >= ssd->width)
+    return;
+  uint8_t *column = &ssd->ram_buffer[x << 3];
+  for (uint8_t page = y0 >> 3, last = y1 >> 3; page <= last; ++page) {
+    uint8_t mask = ssd1306_page_mask(page == y0 >> 3 ? y0 : 0, page == last ? y1 : 7);
+    uint8_t old = column[page], new = value ? old | mask : old & ~mask;
+    if (new != old) {
+      column[page] = new;
+      ssd1306_mark_dirty(ssd, x, page);
+    }
+  }
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
-  uint16_t index = 0;
-  char ver=c;
-  if (c>= '!' && c <= '~') {
-    index = (c - '!' + 1) * 6; // Adiciona todos os caracteres declarados em font.h
+// Grava height linhas (até 32) da coluna x a partir de y com bits (bit 0 = linha y), cortando o que
+// passa da tela. Com y alinhado à página cada byte é uma escrita direta; fora do alinhamento o
+// deslocamento e a máscara juntam as linhas com o que já está nas duas páginas tocadas.
+static void ssd1306_column(ssd1306_t *ssd, uint8_t x, uint8_t y, uint32_t bits, uint8_t height) {
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+  if (y + height > ssd->height)
+    height = ssd->height - y;
+  uint8_t *column = &ssd->ram_buffer[x << 3];
+  uint8_t page = y >> 3;
+  uint64_t data = (uint64_t)bits << (y & 7);
+  uint64_t mask = (((uint64_t)1 << height) - 1) << (y & 7);
+  for (; mask; mask >>= 8, data >>= 8, ++page) {
+    uint8_t m = mask, old = column[page];
+    uint8_t new = m == 0xFF ? (uint8_t)data : (old & ~m) | (data & m);
+    if (new != old) {
+      column[page] = new;
+      ssd1306_mark_dirty(ssd, x, page);
+    }
   }
-  for (uint8_t i = 0; i < 6; ++i) {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j) {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+}
+
+// Repete cada linha da coluna scale vezes (ampliação vertical)
+static uint32_t ssd1306_scale_column(uint8_t bits, uint8_t scale) {
+  if (scale == 1)
+    return bits;
+  uint32_t out = 0, run = (1u << scale) - 1;
+  for (uint8_t i = 0; bits; ++i, bits >>= 1)
+    if (bits & 1)
+      out |= run << (i * scale);
+  return out;
+}
+
+// Desenha um caractere ampliado scale vezes (1 a 4) e retorna a largura ocupada, com o espaçamento.
+// As colunas do espaçamento são apagadas, como as colunas em branco da fonte monoespaçada.
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const font_t *font, char c, uint8_t x, uint8_t y, uint8_t scale) {
+  if (scale < 1)
+    scale = 1;
+  if (scale > 4)
+    scale = 4;
+  uint8_t width;
+  const uint8_t *glyph = font_glyph(font, c, &width);
+  uint8_t total = width + font->spacing;
+
+  // Caso comum, tamanho normal inteiro na tela: em linha de página cada coluna é um byte copiado
+  // direto; fora dela, cada coluna vira duas metades deslocadas nas duas páginas tocadas
+  if (scale == 1 && y + 8 <= ssd->height && x + total <= ssd->width) {
+    uint8_t page = y >> 3, shift = y & 7;
+    uint8_t *out = &ssd->ram_buffer[(x << 3) + page];
+    uint8_t m0 = 0xFF << shift, m1 = ~m0;
+    int16_t x0 = -1, x1 = -1;
+    for (uint8_t i = 0; i < total; ++i, out += 8) {
+      uint8_t bits = i < width ? glyph[i] : 0;
+      uint8_t lo = shift ? (out[0] & m1) | (uint8_t)(bits << shift) : bits;
+      bool changed = lo != out[0];
+      out[0] = lo;
+      if (shift) {
+        uint8_t hi = (out[1] & m0) | (bits >> (8 - shift));
+        changed |= hi != out[1];
+        out[1] = hi;
+      }
+      if (changed) {
+        if (x0 < 0)
+          x0 = i;
+        x1 = i;
+      }
     }
+    if (x0 >= 0)
+      ssd1306_mark_region(ssd, x + x0, y, x + x1, y + 7);
+    return total;
   }
+
+  uint8_t height = 8 * scale;
+  for (uint8_t i = 0; i < total; ++i) {
+    uint32_t bits = i < width ? ssd1306_scale_column(glyph[i], scale) : 0;
+    for (uint8_t r = 0; r < scale; ++r)
+      ssd1306_column(ssd, x + i * scale + r, y, bits, height);
+  }
+  return total * scale;
+}
+
+// Texto em uma linha, sem quebra; retorna a coluna seguinte ao último caractere
+uint16_t ssd1306_draw_text(ssd1306_t *ssd, const font_t *font, const char *str, uint8_t x, uint8_t y, uint8_t scale) {
+  uint16_t cx = x;
+  while (*str && cx < ssd->width)
+    cx += ssd1306_draw_glyph(ssd, font, *str++, cx, y, scale);
+  return cx;
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+  ssd1306_draw_glyph(ssd, &font_6x8, c, x, y, 1);
 }
 
 // Função para desenhar uma string
@@ -168,4 +434,4 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
       break;
     }
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,91 @@
+#include "telemetria.h"
+#include "quadro.h"
+
+static uint8_t lote[TELEMETRIA_CABECALHO + TELEMETRIA_LOTE * TELEMETRIA_AMOSTRA + 2]; // + CRC
+static uint8_t amostras; // No lote atual
+static uint32_t t0;
+static uint16_t sequencia;
+static uint32_t quadros, descartados;
+
+// Fila circular de bytes já codificados; o núcleo 1 é o único produtor e consumidor
+static uint8_t fila[TELEMETRIA_FILA];
+static uint16_t cabeca, cauda, ocupados;
+
+static void poe16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+static void fecha_lote(void) {
+  if (!amostras)
+    return;
+  lote[0] = TELEMETRIA_VERSAO;
+  poe16(&lote[1], sequencia++);
+  poe16(&lote[3], t0 & 0xFFFF);
+  poe16(&lote[5], t0 >> 16);
+  lote[7] = amostras;
+  uint8_t quadro[QUADRO_MAX(sizeof lote - 2)];
+  size_t total = quadro_montar(lote, TELEMETRIA_CABECALHO + amostras * TELEMETRIA_AMOSTRA, quadro);
+  amostras = 0;
+  quadros++;
+  if (total > (size_t)(TELEMETRIA_FILA - ocupados)) {
+    descartados++;
+    return;
+  }
+  for (size_t i = 0; i < total; ++i) {
+    fila[cauda] = quadro[i];
+    cauda = (cauda + 1) % TELEMETRIA_FILA;
+  }
+  ocupados += total;
+}
+
+void telemetria_adicionar(const telemetria_amostra_t *a) {
+  if (amostras && a->t_ms - t0 > TELEMETRIA_LOTE_MAX_MS)
+    fecha_lote();
+  if (!amostras)
+    t0 = a->t_ms;
+  uint8_t *p = &lote[TELEMETRIA_CABECALHO + amostras * TELEMETRIA_AMOSTRA];
+  poe16(&p[0], a->t_ms - t0);
+  p[2] = a->zona;
+  poe16(&p[3], a->luz);
+  poe16(&p[5], a->umidade_adc);
+  poe16(&p[7], a->umidade);
+  p[9] = a->rele | (a->alerta & 7) << 1 | (a->tela & 3) << 4;
+  p[10] = a->ideal;
+  p[11] = a->tempo_rega;
+  if (++amostras == TELEMETRIA_LOTE)
+    fecha_lote();
+}
+
+// Até duas escritas por chamada: o trecho contíguo até o fim do buffer e o começo após a volta
+void telemetria_enviar(void) {
+  size_t livre = hal_serial_livre();
+  while (ocupados && livre) {
+    size_t trecho = TELEMETRIA_FILA - cabeca;
+    if (trecho > ocupados)
+      trecho = ocupados;
+    if (trecho > livre)
+      trecho = livre;
+    hal_serial_escrever_bruto(&fila[cabeca], trecho);
+    cabeca = (cabeca + trecho) % TELEMETRIA_FILA;
+    ocupados -= trecho;
+    livre -= trecho;
+  }
+}
+
+void telemetria_descarregar(void) {
+  while (ocupados) {
+    size_t trecho = TELEMETRIA_FILA - cabeca < ocupados ? TELEMETRIA_FILA - cabeca : ocupados;
+    hal_serial_escrever_bruto(&fila[cabeca], trecho);
+    cabeca = (cabeca + trecho) % TELEMETRIA_FILA;
+    ocupados -= trecho;
+  }
+}
+
+uint32_t telemetria_quadros(void) {
+  return quadros;
+}
+
+uint32_t telemetria_descartados(void) {
+  return descartados;
+}
@@ -0,0 +1,39 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include "hal.h"
+
+// Telemetria binária do núcleo 1: amostras em lotes, um quadro (quadro.h) por lote, colocados em
+// uma fila de envio esvaziada só com o espaço livre da serial, sem nunca bloquear. Sem espaço na
+// fila o quadro é descartado; a sequência continua contando e o decodificador vê a lacuna.
+//
+// Conteúdo do quadro (little-endian):
+//   [versao u8][sequencia u16][t0 u32, ms desde o boot][n u8]
+//   n x [dt u16, ms desde t0][zona u8][luz u16][umidade_adc u16][umidade u16, Q8.8 %][flags u8][ideal u8][tempo_rega u8]
+//   umidade_adc e umidade = 0xFFFF para zona sem leitura (ZONA_SEM_LEITURA)
+//   flags: bit 0 = relé, bits 1-3 = alerta (alerta_t), bits 4-5 = tela (tela_t)
+
+#define TELEMETRIA_VERSAO 2
+#define TELEMETRIA_LOTE 8 // Amostras por quadro (800 ms no modo normal)
+#define TELEMETRIA_LOTE_MAX_MS 60000 // Fecha o lote antes que dt estoure 16 bits
+#define TELEMETRIA_CABECALHO 8
+#define TELEMETRIA_AMOSTRA 12
+#define TELEMETRIA_FILA 1024 // Bytes: ~10 quadros cheios
+
+typedef struct {
+  uint32_t t_ms;
+  uint8_t zona;
+  uint16_t luz, umidade_adc; // Leituras do ADC (12 bits)
+  uint16_t umidade; // Q8.8 %
+  bool rele; // Relé da zona ligado
+  uint8_t alerta, tela;
+  int8_t ideal, tempo_rega;
+} telemetria_amostra_t;
+
+void telemetria_adicionar(const telemetria_amostra_t *a); // Fecha e enfileira o quadro com o lote cheio
+void telemetria_enviar(void); // Passa à serial o que couber sem bloquear
+void telemetria_descarregar(void); // Envia os quadros da fila, bloqueando (antes de texto ou outra saída binária)
+uint32_t telemetria_quadros(void);
+uint32_t telemetria_descartados(void); // Quadros perdidos por falta de espaço na fila
+
+#endif
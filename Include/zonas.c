@@ -0,0 +1,114 @@
+#include "zonas.h"
+
+static const zona_config_t *zonas;
+static uint8_t total;
+
+// Zonas de cada fonte sequencial, na ordem da tabela, e a posição da leitura em andamento
+static uint8_t mux[ZONAS_MAX], mux_total, mux_atual;
+static uint8_t ads[ZONAS_MAX], ads_total, ads_atual;
+static bool ads_convertendo; // Conversão da zona ads_atual iniciada: sem ela a leitura seria a de outra zona
+static uint32_t falhas_i2c;
+
+static void mux_selecionar(uint8_t zona) {
+  uint8_t canal = zonas[zona].canal;
+  hal_gpio_put(ZONAS_MUX_PINO_A, canal & 1);
+  hal_gpio_put(ZONAS_MUX_PINO_B, canal & 2);
+  hal_gpio_put(ZONAS_MUX_PINO_C, canal & 4);
+}
+
+// Conversão única no canal (AINx contra GND): OS, MUX = 4 + canal, PGA = 4,096 V, modo único;
+// 860 amostras/s, comparador desligado
+static void ads_iniciar(uint8_t zona) {
+  uint8_t config[3] = {0x01, 0xC3 | (zonas[zona].canal & 3) << 4, 0xE3};
+  ads_convertendo = hal_i2c_escrever(ZONAS_I2C, ZONAS_I2C_ENDERECO, config, sizeof config);
+}
+
+// Resultado da última conversão, reescalado para 12 bits como o ADC interno. Sem resposta dentro
+// do prazo do I2C (ou sem a conversão iniciada) a zona fica sem leitura.
+static uint16_t ads_ler(void) {
+  uint8_t ponteiro = 0x00, b[2];
+  if (!ads_convertendo || !hal_i2c_escrever(ZONAS_I2C, ZONAS_I2C_ENDERECO, &ponteiro, 1) ||
+      !hal_i2c_ler(ZONAS_I2C, ZONAS_I2C_ENDERECO, b, sizeof b)) {
+    falhas_i2c++;
+    return ZONA_SEM_LEITURA;
+  }
+  int16_t v = (int16_t)(b[0] << 8 | b[1]);
+  uint32_t adc = v > 0 ? (uint32_t)v * 4095 / ZONAS_I2C_3V3 : 0;
+  return adc > 4095 ? 4095 : adc;
+}
+
+// Espera bloqueante da varredura inicial: hal_dormir_ate volta em qualquer evento (interrupções da
+// USB e dos temporizadores no boot), então dorme de novo até o prazo
+static void esperar_ms(uint32_t ms) {
+  uint64_t prazo = hal_tempo_us() + ms * 1000ull;
+  while (hal_tempo_us() < prazo)
+    hal_dormir_ate(prazo);
+}
+
+static void ler_diretas(uint16_t *adc) {
+  for (uint8_t z = 0; z < total; ++z)
+    if (zonas[z].fonte == ZONA_ADC)
+      adc[z] = hal_adc_ler(zonas[z].canal);
+}
+
+void zonas_init(const zona_config_t *tabela, uint8_t n, uint16_t *adc) {
+  zonas = tabela;
+  total = n > ZONAS_MAX ? ZONAS_MAX : n;
+  mux_total = ads_total = mux_atual = ads_atual = 0;
+  for (uint8_t z = 0; z < total; ++z) {
+    if (zonas[z].fonte == ZONA_MUX)
+      mux[mux_total++] = z;
+    else if (zonas[z].fonte == ZONA_I2C)
+      ads[ads_total++] = z;
+  }
+  if (mux_total) {
+    hal_gpio_saida(ZONAS_MUX_PINO_A);
+    hal_gpio_saida(ZONAS_MUX_PINO_B);
+    hal_gpio_saida(ZONAS_MUX_PINO_C);
+  }
+
+  // Varredura inicial completa: o controle nunca decide sobre uma zona ainda não lida
+  ler_diretas(adc);
+  for (uint8_t i = 0; i < mux_total; ++i) {
+    mux_selecionar(mux[i]);
+    esperar_ms(ZONAS_MUX_ACOMODACAO_MS);
+    adc[mux[i]] = hal_adc_ler(SENSOR_CANAL_MUX);
+  }
+  for (uint8_t i = 0; i < ads_total; ++i) {
+    ads_iniciar(ads[i]);
+    esperar_ms(ZONAS_I2C_CONVERSAO_MS);
+    adc[ads[i]] = ads_ler();
+  }
+
+  // Primeira leitura sequencial já em andamento para a próxima varredura
+  if (mux_total)
+    mux_selecionar(mux[0]);
+  if (ads_total)
+    ads_iniciar(ads[0]);
+}
+
+void zonas_varrer(uint16_t *adc) {
+  ler_diretas(adc);
+  if (mux_total) {
+    adc[mux[mux_atual]] = hal_adc_ler(SENSOR_CANAL_MUX);
+    mux_atual = (mux_atual + 1) % mux_total;
+    mux_selecionar(mux[mux_atual]);
+  }
+  if (ads_total) {
+    adc[ads[ads_atual]] = ads_ler();
+    ads_atual = (ads_atual + 1) % ads_total;
+    ads_iniciar(ads[ads_atual]);
+  }
+}
+
+uint8_t zonas_total(void) {
+  return total;
+}
+
+const zona_config_t *zonas_config(uint8_t zona) {
+  return &zonas[zona];
+}
+
+uint32_t zonas_falhas_i2c(void) {
+  return falhas_i2c;
+}
@@ -0,0 +1,53 @@
+#ifndef ZONAS_H
+#define ZONAS_H
+
+#include "hal.h"
+
+// Zonas de irrigação (vasos): tabela com a origem da leitura de umidade, o relé e os valores
+// iniciais de ideal e tempo de rega de cada zona. A leitura pode vir de um canal direto do ADC,
+// de um multiplexador analógico (CD4051, 8 canais) na entrada SENSOR_CANAL_MUX ou de um ADC I2C
+// (ADS1115, 4 canais) no i2c0.
+//
+// A varredura tem custo limitado por chamada: os canais diretos são lidos todos (o ADC já roda em
+// segundo plano), mas o multiplexador e o ADC I2C avançam uma zona por chamada, cada leitura
+// iniciada na chamada anterior (o multiplexador teve o período inteiro para acomodar, o ADS1115
+// para converter). Com M zonas no multiplexador, cada uma é relida a cada M chamadas.
+
+#define ZONAS_MAX 8
+#define ZONA_SEM_LEITURA 0xFFFF // Zona sem leitura válida (ADC I2C sem resposta no prazo): nunca é regada
+
+// Multiplexador: seleção binária nos pinos A (bit 0), B e C
+#define ZONAS_MUX_PINO_A 16
+#define ZONAS_MUX_PINO_B 17
+#define ZONAS_MUX_PINO_C 18
+#define ZONAS_MUX_ACOMODACAO_MS 30 // Espera após trocar de canal, só na varredura inicial
+
+// ADC I2C: ADS1115 com ADDR no GND, conversão única a 860 amostras/s, fundo de escala 4,096 V
+#define ZONAS_I2C i2c0
+#define ZONAS_I2C_ENDERECO 0x48
+#define ZONAS_I2C_CONVERSAO_MS 2
+#define ZONAS_I2C_3V3 26400 // Leitura do ADS1115 para 3,3 V
+
+typedef enum {
+  ZONA_ADC, // Canal direto do ADC (SENSOR_CANAL_*)
+  ZONA_MUX, // Canal 0-7 do multiplexador
+  ZONA_I2C, // Canal 0-3 do ADS1115
+} zona_fonte_t;
+
+typedef struct {
+  const char *nome;
+  zona_fonte_t fonte;
+  uint8_t canal;
+  uint8_t pino_rele;
+  int8_t ideal; // Umidade ideal inicial (%)
+  int8_t tempo_rega; // Tempo de rega inicial (s)
+} zona_config_t;
+
+// Configura os pinos do multiplexador e faz uma varredura completa bloqueante (antes das tarefas)
+void zonas_init(const zona_config_t *tabela, uint8_t total, uint16_t *adc);
+void zonas_varrer(uint16_t *adc); // Atualiza adc[zona] (12 bits ou ZONA_SEM_LEITURA)
+uint8_t zonas_total(void);
+const zona_config_t *zonas_config(uint8_t zona);
+uint32_t zonas_falhas_i2c(void);
+
+#endif
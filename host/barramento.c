@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <string.h>
+#include "barramento.h"
+#include "hal_linux.h"
+
+#define TRANSMISSOES 4 // Quadros na linha ao mesmo tempo (mais de um só em colisão)
+#define VIRTUAL_RESPOSTA_US 300 // Do fim da consulta ao primeiro bit da resposta de um nó virtual
+#define PASSO_US 10000 // Passo máximo do modelo dos nós virtuais e da contagem de bombas
+#define INTERVALO_US 2000000 // Entre duas regas de um nó virtual, como intervalo_zonas_ms
+#define GANHO_PCT_S 3.0 // Como o ganho_pct_s padrão de hal_linux
+#define HISTERESE_PCT 5
+
+typedef struct {
+  uint8_t dados[REDE_QUADRO_MAX];
+  uint8_t total;
+  uint8_t origem; // Endereço do nó; 0 = coordenador
+  uint64_t inicio_us, fim_us;
+  bool usada, colidiu;
+} transmissao_t;
+
+typedef struct {
+  rede_no_t no;
+  uint8_t ideal[ZONAS_MAX], rega[ZONAS_MAX];
+  double umidade[ZONAS_MAX], secagem_pct_h;
+  bool ciclo[ZONAS_MAX]; // Com sede até passar do limiar mais a histerese
+  int8_t irrigando;
+  uint64_t fim_us; // Fim da rega em andamento ou da última
+  uint64_t modelo_us;
+  uint8_t regas;
+} no_virtual_t;
+
+static barramento_config_t cfg;
+static barramento_estatisticas_t est;
+static rede_coord_t coord;
+static const rede_coord_t *coord_ativo; // O do barramento ou o do firmware
+static no_virtual_t nos[REDE_NOS_MAX]; // Índice = endereço - 1 (o do firmware fica sem uso)
+static transmissao_t linha[TRANSMISSOES];
+static hal_alarme_t alarme;
+static uint64_t contado_us;
+static uint8_t bombas;
+static uint32_t aleatorio;
+
+static uint32_t sortear(void) {
+  aleatorio = aleatorio * 1103515245u + 12345u;
+  return aleatorio >> 8;
+}
+
+static bool virtual(uint8_t endereco) {
+  return endereco && endereco <= cfg.nos && !(cfg.firmware && !cfg.coordenador && endereco == 1);
+}
+
+// Endereço das transmissões do firmware (0 = coordenador)
+static uint8_t origem_firmware(void) {
+  return cfg.coordenador ? 0 : 1;
+}
+
+// Jardim do nó virtual: seca, rega a zona com sede quando tem a vez (uma rega por vez, com intervalo)
+static void no_avancar(no_virtual_t *v, uint64_t agora) {
+  double dt = (agora - v->modelo_us) / 1e6;
+  v->modelo_us = agora;
+  for (uint8_t z = 0; z < cfg.zonas; ++z) {
+    v->umidade[z] -= v->secagem_pct_h * dt / 3600;
+    if (v->irrigando == z)
+      v->umidade[z] += GANHO_PCT_S * dt;
+    v->umidade[z] = v->umidade[z] < 0 ? 0 : v->umidade[z] > 100 ? 100 : v->umidade[z];
+    if (v->umidade[z] >= v->ideal[z] - 20 + HISTERESE_PCT)
+      v->ciclo[z] = false;
+    else if (v->umidade[z] < v->ideal[z] - 20)
+      v->ciclo[z] = true;
+  }
+  if (v->irrigando >= 0 && agora >= v->fim_us) {
+    v->irrigando = -1;
+    v->fim_us = agora;
+  }
+  if (v->irrigando >= 0 || agora - v->fim_us < INTERVALO_US || !rede_no_liberado(&v->no, agora))
+    return;
+  for (uint8_t z = 0; z < cfg.zonas; ++z) {
+    if (v->ciclo[z]) {
+      v->irrigando = z;
+      v->fim_us = agora + v->rega[z] * 1000000ull;
+      ++v->regas;
+      ++est.regas_virtuais;
+      return;
+    }
+  }
+}
+
+static void no_retrato(const no_virtual_t *v, rede_retrato_t *r) {
+  *r = (rede_retrato_t){.zonas = cfg.zonas, .irrigando = v->irrigando, .luz = 50, .regas = v->regas};
+  for (uint8_t z = 0; z < cfg.zonas; ++z) {
+    r->pedido |= v->ciclo[z];
+    r->umidade[z] = v->umidade[z] + 0.5;
+    r->ideal[z] = v->ideal[z];
+    r->rega[z] = v->rega[z];
+  }
+}
+
+static void transmitir(uint8_t origem, const uint8_t *dados, size_t total, uint64_t inicio) {
+  transmissao_t *t = NULL;
+  for (int i = 0; i < TRANSMISSOES && !t; ++i)
+    if (!linha[i].usada)
+      t = &linha[i];
+  if (!t)
+    return;
+  *t = (transmissao_t){.total = total, .origem = origem, .inicio_us = inicio, .usada = true};
+  t->fim_us = inicio + total * 10000000ull / cfg.baud; // 8N1
+  memcpy(t->dados, dados, total);
+  for (int i = 0; i < TRANSMISSOES; ++i) {
+    transmissao_t *u = &linha[i];
+    if (u != t && u->usada && u->inicio_us < t->fim_us && t->inicio_us < u->fim_us) {
+      u->colidiu = t->colidiu = true;
+      ++est.colisoes;
+    }
+  }
+  for (size_t i = 0; cfg.erro_ppm && i < total; ++i) {
+    if (sortear() % 1000000 < cfg.erro_ppm) {
+      t->dados[i] ^= 1u << (sortear() % 8);
+      ++est.bytes_trocados;
+    }
+  }
+  ++est.quadros;
+  est.ocupado_us += t->fim_us - t->inicio_us;
+}
+
+// Fim de um quadro: todos na linha recebem, menos quem transmitiu; um nó virtual consultado
+// responde depois de VIRTUAL_RESPOSTA_US
+static void entregar(transmissao_t *t) {
+  t->usada = false;
+  if (t->colidiu)
+    for (uint8_t i = 1; i < t->total; i += 2)
+      t->dados[i] ^= 0x5A;
+  if (t->origem && !cfg.coordenador)
+    for (uint8_t i = 0; i < t->total; ++i)
+      rede_coord_byte(&coord, t->dados[i], t->fim_us);
+  if (cfg.firmware && t->origem != origem_firmware())
+    hal_sim_uart_entregar(t->dados, t->total, t->fim_us);
+  for (uint8_t e = 1; e <= cfg.nos; ++e) {
+    if (!virtual(e) || e == t->origem)
+      continue;
+    no_virtual_t *v = &nos[e - 1];
+    for (uint8_t i = 0; i < t->total; ++i) {
+      if (!rede_no_byte(&v->no, t->dados[i], t->fim_us))
+        continue;
+      uint8_t z, ideal, rega;
+      if (rede_no_ajuste(&v->no, &z, &ideal, &rega) && z < cfg.zonas) {
+        v->ideal[z] = ideal;
+        v->rega[z] = rega;
+      }
+      rede_retrato_t r;
+      uint8_t quadro[REDE_QUADRO_MAX];
+      no_avancar(v, t->fim_us);
+      no_retrato(v, &r);
+      transmitir(e, quadro, rede_no_responder(&v->no, &r, quadro), t->fim_us + VIRTUAL_RESPOSTA_US);
+    }
+  }
+}
+
+// Bombas ligadas agora; o tempo acima do orçamento vale desde a contagem anterior
+static void contar_bombas(uint64_t agora) {
+  if (bombas > cfg.bombas_max)
+    est.acima_us += agora - contado_us;
+  contado_us = agora;
+  bombas = cfg.firmware && !cfg.coordenador ? hal_sim_reles_ligados() : 0; // Os do coordenador ficam fora da conta
+  for (uint8_t e = 1; e <= cfg.nos; ++e)
+    bombas += virtual(e) && nos[e - 1].irrigando >= 0;
+  if (bombas > est.bombas_max)
+    est.bombas_max = bombas;
+}
+
+// Um único alarme, reagendado em microssegundos pelo retorno: fim dos quadros, prazos do
+// coordenador e passo dos nós virtuais
+static int64_t evento(hal_alarme_t id, void *ctx) {
+  uint64_t agora = hal_tempo_us();
+  for (int i = 0; i < TRANSMISSOES; ++i)
+    if (linha[i].usada && linha[i].fim_us <= agora)
+      entregar(&linha[i]);
+  for (uint8_t e = 1; e <= cfg.nos; ++e)
+    if (virtual(e))
+      no_avancar(&nos[e - 1], agora);
+  contar_bombas(agora);
+
+  uint64_t proximo = agora + PASSO_US, prazo = 0;
+  if (!cfg.coordenador) {
+    uint8_t quadro[REDE_QUADRO_MAX];
+    size_t n = rede_coord_passo(&coord, agora, quadro);
+    if (n)
+      transmitir(0, quadro, n, agora);
+    prazo = rede_coord_prazo(&coord);
+  }
+  if (prazo > agora && prazo < proximo)
+    proximo = prazo;
+  for (int i = 0; i < TRANSMISSOES; ++i)
+    if (linha[i].usada && linha[i].fim_us < proximo)
+      proximo = linha[i].fim_us > agora ? linha[i].fim_us : agora + 1;
+  for (uint8_t e = 1; e <= cfg.nos; ++e)
+    if (virtual(e) && nos[e - 1].irrigando >= 0 && nos[e - 1].fim_us < proximo)
+      proximo = nos[e - 1].fim_us > agora ? nos[e - 1].fim_us : agora + 1;
+  return -(int64_t)(proximo - agora);
+}
+
+// Quadro do firmware: a linha fica ocupada desde já e o alarme é refeito para o fim do quadro
+static void firmware_enviou(const uint8_t *dados, size_t total, uint64_t inicio_us) {
+  transmitir(origem_firmware(), dados, total, inicio_us);
+  hal_alarme_cancelar(alarme);
+  alarme = hal_alarme_em_ms(0, evento, NULL);
+}
+
+void barramento_iniciar(const barramento_config_t *c) {
+  cfg = *c;
+  if (cfg.nos > REDE_NOS_MAX)
+    cfg.nos = REDE_NOS_MAX;
+  if (cfg.zonas < 1 || cfg.zonas > ZONAS_MAX)
+    cfg.zonas = 1;
+  memset(&est, 0, sizeof est);
+  memset(linha, 0, sizeof linha);
+  contado_us = hal_tempo_us();
+  bombas = 0;
+  aleatorio = 2024;
+  if (!cfg.firmware)
+    cfg.coordenador = NULL;
+  rede_coord_init(&coord, cfg.coordenador ? 0 : cfg.nos, cfg.bombas_max);
+  coord_ativo = cfg.coordenador ? cfg.coordenador : &coord;
+  for (uint8_t e = 1; e <= cfg.nos; ++e) {
+    no_virtual_t *v = &nos[e - 1];
+    *v = (no_virtual_t){.irrigando = -1, .secagem_pct_h = 4 + e % 5, .modelo_us = contado_us};
+    rede_no_init(&v->no, e, contado_us);
+    for (uint8_t z = 0; z < cfg.zonas; ++z) {
+      v->ideal[z] = 50;
+      v->rega[z] = 5;
+      v->umidade[z] = 26 + (e * 37 + z * 11) % 12; // Uns já abaixo do limiar de 30%, outros logo acima
+    }
+  }
+  if (cfg.firmware)
+    hal_sim_uart_conectar(firmware_enviou);
+  alarme = hal_alarme_em_ms(0, evento, NULL);
+}
+
+rede_coord_t *barramento_coordenador(void) {
+  return &coord;
+}
+
+const barramento_estatisticas_t *barramento_estatisticas(void) {
+  return &est;
+}
+
+uint8_t barramento_ajustes_pendentes(void) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < coord_ativo->nos; ++i)
+    n += coord_ativo->no[i].ajustes != 0;
+  return n;
+}
+
+void barramento_relatorio(void) {
+  uint64_t agora = hal_tempo_us();
+  rede_coord_relatorio(coord_ativo, agora);
+  printf("Barramento: %lu quadros, %lu colisões, %lu bytes trocados, linha ocupada %.1f%% do tempo\n",
+         (unsigned long)est.quadros, (unsigned long)est.colisoes, (unsigned long)est.bytes_trocados,
+         agora ? 100.0 * est.ocupado_us / agora : 0.0);
+  printf("Bombas ligadas ao mesmo tempo: máx %u (orçamento %u), %.1f s acima do orçamento\n", est.bombas_max,
+         cfg.bombas_max, est.acima_us / 1e6);
+}
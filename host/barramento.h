@@ -0,0 +1,34 @@
+// Barramento RS-485 simulado sobre o relógio virtual de hal_linux: o coordenador de rede.h, nós
+// virtuais com um jardim mínimo (umidade que cai, rega que só começa com a vez) e, opcionalmente, o
+// firmware pela UART emulada, como nó 1 ou como o próprio coordenador. Cada quadro ocupa a linha pelo tempo dos seus bytes; dois
+// transmissores ao mesmo tempo colidem e os dois quadros chegam corrompidos.
+#ifndef BARRAMENTO_H
+#define BARRAMENTO_H
+
+#include "rede.h"
+
+typedef struct {
+  uint8_t nos; // Endereços 1 a nos
+  bool firmware; // O nó 1 é o firmware (jardim.c, com jardim_rede(1)); os demais são virtuais
+  uint8_t bombas_max; // Orçamento do coordenador
+  uint8_t zonas; // Zonas de cada nó virtual
+  uint32_t baud;
+  uint32_t erro_ppm; // Bytes trocados na linha, por milhão
+  const rede_coord_t *coordenador; // Com firmware: o dele (jardim_coordenador), e todos os nós são virtuais
+} barramento_config_t;
+
+typedef struct {
+  uint32_t quadros, colisoes, bytes_trocados;
+  uint64_t ocupado_us; // Linha com algum transmissor
+  uint8_t bombas_max; // Mais bombas ligadas ao mesmo tempo (nós virtuais e relés do firmware nó), a cada 10 ms no máximo
+  uint64_t acima_us; // Tempo com mais bombas ligadas que o orçamento
+  uint32_t regas_virtuais;
+} barramento_estatisticas_t;
+
+void barramento_iniciar(const barramento_config_t *cfg); // Depois de hal_sim_iniciar
+rede_coord_t *barramento_coordenador(void); // O do barramento (sem uso com o firmware coordenando)
+const barramento_estatisticas_t *barramento_estatisticas(void);
+uint8_t barramento_ajustes_pendentes(void); // Nós com algum ajuste ainda não confirmado
+void barramento_relatorio(void);
+
+#endif
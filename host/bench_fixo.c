@@ -0,0 +1,93 @@
+// Compara o pipeline original em double (divisão, comparações e sprintf "%.0f") com o pipeline em
+// ponto fixo de fixo.h para uma passada do laço principal. No host há FPU, então o ganho medido aqui
+// é um limite inferior do obtido no Cortex-M0+, onde cada operação em double é emulada em software.
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "fixo.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UNIDADE "ciclos"
+static inline uint64_t contador(void) { return __rdtsc(); }
+#else
+#define UNIDADE "ns"
+static inline uint64_t contador(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+#define REPETICOES 200000
+
+static char str_luz[7], str_umid[7];
+static int nivel_led, estado_rega;
+static volatile int sorvedouro;
+
+// Passada original: mesma sequência de operações do Garden.c antes da conversão
+static int passada_double(uint16_t luz, uint16_t umid, int8_t ideal) {
+  double intensidade = 1 - luz / 4095.0;
+  sprintf(str_luz, "%.0f%%", (1 - intensidade) * 100);
+  unsigned char nivel = intensidade * 255;
+  double umidade = umid / 4095.0;
+  sprintf(str_umid, "%.0f%%", umidade * 100);
+  int estado = 0;
+  if (umidade * 100 < (ideal - 20))
+    estado = 1;
+  else if (umidade * 100 > (ideal - 20) && umidade * 100 < (ideal + 20))
+    estado = 2;
+  else if (umidade * 100 > (ideal + 20))
+    estado = 3;
+  nivel_led = nivel;
+  estado_rega = estado;
+  return estado + nivel + str_luz[0] + str_umid[0];
+}
+
+static int passada_fixo(uint16_t luz, uint16_t umid, int8_t ideal) {
+  uint8_t nivel = 255 - adc_para_nivel(luz);
+  fmt_uint(str_luz, q8_arredonda(adc_para_pct_q8(luz)), '%');
+  uint16_t umidade = adc_para_pct_q8(umid);
+  fmt_uint(str_umid, q8_arredonda(umidade), '%');
+  int estado = 0;
+  if (umidade < PCT_Q8(ideal - 20))
+    estado = 1;
+  else if (umidade > PCT_Q8(ideal - 20) && umidade < PCT_Q8(ideal + 20))
+    estado = 2;
+  else if (umidade > PCT_Q8(ideal + 20))
+    estado = 3;
+  nivel_led = nivel;
+  estado_rega = estado;
+  return estado + nivel + str_luz[0] + str_umid[0];
+}
+
+int main(void) {
+  // Confere, para todas as leituras, que a decisão de rega é idêntica e que texto e nível do LED
+  // diferem no máximo pelo arredondamento (o double truncava o nível; o ponto fixo arredonda)
+  int decisao = 0, texto = 0, nivel = 0;
+  for (uint16_t adc = 0; adc < 4096; ++adc) {
+    char d_luz[7], d_umid[7];
+    passada_double(adc, adc, 50);
+    int d_estado = estado_rega, d_nivel = nivel_led;
+    strcpy(d_luz, str_luz);
+    strcpy(d_umid, str_umid);
+    passada_fixo(adc, adc, 50);
+    decisao += d_estado != estado_rega;
+    texto += strcmp(d_luz, str_luz) != 0 || strcmp(d_umid, str_umid) != 0;
+    nivel += d_nivel - nivel_led > 1 || nivel_led - d_nivel > 1;
+  }
+
+  uint64_t t0 = contador();
+  for (int i = 0; i < REPETICOES; ++i)
+    sorvedouro = passada_double(i & 4095, (i * 7) & 4095, 50);
+  double antes = (double)(contador() - t0) / REPETICOES;
+
+  t0 = contador();
+  for (int i = 0; i < REPETICOES; ++i)
+    sorvedouro = passada_fixo(i & 4095, (i * 7) & 4095, 50);
+  double depois = (double)(contador() - t0) / REPETICOES;
+
+  printf("passada do laço (" UNIDADE "): double %.1f, ponto fixo %.1f, ganho %.1fx\n", antes, depois, antes / depois);
+  printf("divergências em 4096 leituras: decisão %d, texto %d, nível do LED (>1) %d\n", decisao, texto, nivel);
+  return 0;
+}
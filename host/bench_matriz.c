@@ -0,0 +1,78 @@
+// Transposição do quadro para as fitas WS2812 em paralelo (programa matriz_paralelo): compara a
+// versão bit a bit com matriz_leds_transpor (8x8 bits em palavras de 32 bits) e confere que as duas
+// geram os mesmos bytes. Mostra também o tempo de linha do quadro com as fitas encadeadas em um só
+// pino e com elas em paralelo. Mede ciclos (TSC em x86) ou nanossegundos nos demais hosts.
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "matriz_leds.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UNIDADE "ciclos"
+static inline uint64_t contador(void) { return __rdtsc(); }
+#else
+#define UNIDADE "ns"
+static inline uint64_t contador(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+#define REPETICOES 20000
+#define US_POR_BIT 1.25 // 10 ciclos de 8 MHz
+
+static uint32_t grb[MATRIZ_FITAS_MAX * MATRIZ_LEDS];
+static uint8_t planos_ref[MATRIZ_LEDS * MATRIZ_BITS_LED], planos[MATRIZ_LEDS * MATRIZ_BITS_LED];
+static volatile uint8_t sorvedouro;
+
+// Referência: um bit de cada vez
+static void ref_transpor(const uint32_t *quadro, uint8_t fitas, uint8_t leds, uint8_t *saida) {
+  for (uint8_t led = 0; led < leds; ++led) {
+    for (uint8_t k = 0; k < MATRIZ_BITS_LED; ++k) {
+      uint8_t byte = 0;
+      for (uint8_t f = 0; f < fitas; ++f)
+        if (quadro[f * leds + led] & (1u << (31 - k)))
+          byte |= 1u << f;
+      saida[led * MATRIZ_BITS_LED + k] = byte;
+    }
+  }
+}
+
+#define MEDIR(expr)                                                 \
+  ({                                                                \
+    uint64_t t0 = contador();                                       \
+    for (int i = 0; i < REPETICOES; ++i) {                          \
+      grb[i % (MATRIZ_FITAS_MAX * MATRIZ_LEDS)] ^= 0x100u;          \
+      expr;                                                         \
+      sorvedouro = planos[i % sizeof planos];                       \
+    }                                                               \
+    (double)(contador() - t0) / REPETICOES;                         \
+  })
+
+int main(void) {
+  uint32_t semente = 12345;
+  for (size_t i = 0; i < MATRIZ_FITAS_MAX * MATRIZ_LEDS; ++i) {
+    semente = semente * 1103515245u + 12345u;
+    grb[i] = semente & 0xFFFFFF00u;
+  }
+
+  int diferentes = 0;
+  for (uint8_t fitas = 1; fitas <= MATRIZ_FITAS_MAX; ++fitas) {
+    ref_transpor(grb, fitas, MATRIZ_LEDS, planos_ref);
+    matriz_leds_transpor(grb, fitas, MATRIZ_LEDS, planos);
+    diferentes += memcmp(planos_ref, planos, sizeof planos) != 0;
+  }
+  printf("Transposição conferida com 1 a %d fitas: %s\n\n", MATRIZ_FITAS_MAX, diferentes ? "DIFERENTE" : "igual");
+
+  printf("%-6s %14s %14s %8s %16s %16s\n", "fitas", "bit a bit", "8x8", "ganho", "linha em série", "linha paralela");
+  for (uint8_t fitas = 1; fitas <= MATRIZ_FITAS_MAX; fitas *= 2) {
+    double a = MEDIR(ref_transpor(grb, fitas, MATRIZ_LEDS, planos));
+    double d = MEDIR(matriz_leds_transpor(grb, fitas, MATRIZ_LEDS, planos));
+    double serie = fitas * MATRIZ_LEDS * MATRIZ_BITS_LED * US_POR_BIT, paralelo = MATRIZ_LEDS * MATRIZ_BITS_LED * US_POR_BIT;
+    printf("%-6u %14.1f %14.1f %7.1fx %13.0f us %13.0f us\n", fitas, a, d, a / d, serie, paralelo);
+  }
+  printf("\n(" UNIDADE " por quadro de %d LEDs por fita)\n", MATRIZ_LEDS);
+  return diferentes != 0;
+}
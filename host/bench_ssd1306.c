@@ -0,0 +1,173 @@
+// Microbenchmark das primitivas de desenho do ssd1306: compara as versões originais, pixel a pixel,
+// com as versões por byte/página atuais. Mede ciclos (TSC em x86) ou nanossegundos nos demais hosts.
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UNIDADE "ciclos"
+static inline uint64_t contador(void) { return __rdtsc(); }
+#else
+#define UNIDADE "ns"
+static inline uint64_t contador(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+#define REPETICOES 20000
+
+// Implementações originais (pixel a pixel), mantidas aqui apenas como referência de medição
+static void ref_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  uint16_t index = (y >> 3) + (x << 3);
+  uint8_t pixel = (y & 0b111);
+  if (value)
+    ssd->ram_buffer[index] |= (1 << pixel);
+  else
+    ssd->ram_buffer[index] &= ~(1 << pixel);
+}
+
+static void ref_fill(ssd1306_t *ssd, bool value) {
+  for (uint8_t y = 0; y < ssd->height; ++y)
+    for (uint8_t x = 0; x < ssd->width; ++x)
+      ref_pixel(ssd, x, y, value);
+}
+
+static void ref_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ref_pixel(ssd, x, top, value);
+    ref_pixel(ssd, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ref_pixel(ssd, left, y, value);
+    ref_pixel(ssd, left + width - 1, y, value);
+  }
+  if (fill)
+    for (uint8_t x = left + 1; x < left + width - 1; ++x)
+      for (uint8_t y = top + 1; y < top + height - 1; ++y)
+        ref_pixel(ssd, x, y, value);
+}
+
+static void ref_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint8_t x = x0; x <= x1; ++x)
+    ref_pixel(ssd, x, y, value);
+}
+
+static void ref_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint8_t y = y0; y <= y1; ++y)
+    ref_pixel(ssd, x, y, value);
+}
+
+// Caractere pixel a pixel, ampliado scale vezes (a versão original só tinha scale = 1)
+static void ref_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, uint8_t scale) {
+  const uint8_t *glyph = font_glyph(&font_6x8, c, NULL);
+  for (uint8_t i = 0; i < 6 * scale; ++i)
+    for (uint8_t j = 0; j < 8 * scale; ++j)
+      ref_pixel(ssd, x + i, y + j, glyph[i / scale] & (1 << (j / scale)));
+}
+
+static void ref_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+  for (; *str; ++str, x += 6)
+    ref_draw_char(ssd, *str, x, y, 1);
+}
+
+static void ref_draw_text(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, uint8_t scale) {
+  for (; *str; ++str, x += 6 * scale)
+    ref_draw_char(ssd, *str, x, y, scale);
+}
+
+// Quadro típico do laço principal do Garden.c: limpa, escreve os textos e desenha a borda
+static void desenha_texto(ssd1306_t *ssd, bool novo, const char *str, uint8_t x, uint8_t y) {
+  if (novo)
+    ssd1306_draw_string(ssd, str, x, y);
+  else
+    ref_draw_string(ssd, str, x, y);
+}
+
+static void quadro(ssd1306_t *ssd, bool novo) {
+  if (novo)
+    ssd1306_fill(ssd, 0);
+  else
+    ref_fill(ssd, 0);
+  desenha_texto(ssd, novo, "Luminosidade:", 3, 4);
+  desenha_texto(ssd, novo, "37%", 102, 4);
+  desenha_texto(ssd, novo, "Umidade do solo:", 3, 16);
+  desenha_texto(ssd, novo, "42%", 102, 16);
+  desenha_texto(ssd, novo, "Umidade Ideal:", 3, 28);
+  desenha_texto(ssd, novo, "50%", 102, 28);
+  desenha_texto(ssd, novo, "Tempo de Rega:", 3, 40);
+  desenha_texto(ssd, novo, "5s", 102, 40);
+  desenha_texto(ssd, novo, "Rega em breve!", 3, 52);
+  if (novo)
+    ssd1306_rect(ssd, 1, 1, 126, 62, 1, 0);
+  else
+    ref_rect(ssd, 1, 1, 126, 62, 1, 0);
+}
+
+static volatile uint8_t sorvedouro;
+
+#define MEDIR(expr)                                                 \
+  ({                                                                \
+    uint64_t t0 = contador();                                       \
+    for (int i = 0; i < REPETICOES; ++i) {                          \
+      expr;                                                         \
+      sorvedouro = ssd.ram_buffer[i & 1023];                        \
+    }                                                               \
+    (double)(contador() - t0) / REPETICOES;                         \
+  })
+
+static void linha(const char *nome, double antes, double depois) {
+  printf("%-22s %12.1f %12.1f %8.1fx\n", nome, antes, depois, antes / depois);
+}
+
+int main(void) {
+  ssd1306_t ssd;
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+
+  printf("%-22s %12s %12s %9s\n", "primitiva (" UNIDADE ")", "pixel", "byte/pagina", "ganho");
+
+  double a, d;
+  a = MEDIR(ref_fill(&ssd, i & 1));
+  d = MEDIR(ssd1306_fill(&ssd, i & 1));
+  linha("fill", a, d);
+
+  a = MEDIR(ref_rect(&ssd, 1, 1, 126, 62, i & 1, false));
+  d = MEDIR(ssd1306_rect(&ssd, 1, 1, 126, 62, i & 1, false));
+  linha("rect borda", a, d);
+
+  a = MEDIR(ref_rect(&ssd, 3, 5, 100, 40, i & 1, true));
+  d = MEDIR(ssd1306_rect(&ssd, 3, 5, 100, 40, i & 1, true));
+  linha("rect cheio", a, d);
+
+  a = MEDIR(ref_hline(&ssd, 0, 127, 13, i & 1));
+  d = MEDIR(ssd1306_hline(&ssd, 0, 127, 13, i & 1));
+  linha("hline", a, d);
+
+  a = MEDIR(ref_vline(&ssd, 64, 0, 63, i & 1));
+  d = MEDIR(ssd1306_vline(&ssd, 64, 0, 63, i & 1));
+  linha("vline", a, d);
+
+  // Textos: y = 16 é alinhado à página (cópia direta das colunas), y = 4 cai entre duas páginas
+  const char *texto[2] = {"Umidade do solo:", "Tempo de Rega:  "};
+  a = MEDIR(ref_draw_string(&ssd, texto[i & 1], 3, 16));
+  d = MEDIR(ssd1306_draw_string(&ssd, texto[i & 1], 3, 16));
+  linha("texto alinhado", a, d);
+
+  a = MEDIR(ref_draw_string(&ssd, texto[i & 1], 3, 4));
+  d = MEDIR(ssd1306_draw_string(&ssd, texto[i & 1], 3, 4));
+  linha("texto desalinhado", a, d);
+
+  const char *valor[2] = {"42%", "100%"};
+  a = MEDIR(ref_draw_text(&ssd, valor[i & 1], 40, 20, 3));
+  d = MEDIR(ssd1306_draw_text(&ssd, &font_6x8, valor[i & 1], 40, 20, 3));
+  linha("texto 3x", a, d);
+
+  a = MEDIR(quadro(&ssd, false));
+  d = MEDIR(quadro(&ssd, true));
+  linha("quadro Garden", a, d);
+
+  return 0;
+}
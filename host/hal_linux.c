@@ -0,0 +1,774 @@
+// Implementação da HAL (hal.h) para o host: relógio virtual, alarmes disparados em ordem de prazo,
+// modelo simples do jardim (um ou mais vasos) por trás do ADC, do multiplexador e de um ADS1115
+// emulado, e um SSD1306 emulado a partir do tráfego I2C.
+// Tudo roda em uma única thread: o "núcleo 1" é chamado pelo laço da simulação entre as tarefas.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hal_linux.h"
+#include "zonas.h"
+#include "agua.h"
+
+i2c_inst_t i2c0_inst = {0}, i2c1_inst = {1};
+
+static hal_sim_config_t cfg;
+static hal_sim_estatisticas_t est;
+static uint64_t agora_us;
+
+// Alarmes ------------------------------------------------------------------------------------------
+
+#define ALARMES_MAX 16
+
+typedef struct {
+  hal_alarme_t id; // 0 = posição livre
+  uint64_t prazo_us;
+  hal_alarme_fn_t fn;
+  void *ctx;
+} alarme_t;
+
+static alarme_t alarmes[ALARMES_MAX];
+static hal_alarme_t proximo_id = 1;
+
+static alarme_t *alarme_mais_cedo(void) {
+  alarme_t *a = NULL;
+  for (int i = 0; i < ALARMES_MAX; ++i)
+    if (alarmes[i].id && (!a || alarmes[i].prazo_us < a->prazo_us))
+      a = &alarmes[i];
+  return a;
+}
+
+static hal_alarme_t alarme_inserir(uint64_t prazo_us, hal_alarme_fn_t fn, void *ctx) {
+  for (int i = 0; i < ALARMES_MAX; ++i) {
+    if (!alarmes[i].id) {
+      alarmes[i] = (alarme_t){proximo_id++, prazo_us, fn, ctx};
+      return alarmes[i].id;
+    }
+  }
+  return -1; // Pool esgotado, como no SDK
+}
+
+// Executa o callback e aplica o reagendamento com a mesma convenção do SDK: positivo = relativo ao
+// prazo anterior, negativo = relativo ao instante do disparo
+static void alarme_disparar(alarme_t *a) {
+  alarme_t copia = *a;
+  a->id = 0;
+  est.alarmes_disparados++;
+  int64_t r = copia.fn(copia.id, copia.ctx);
+  if (r == 0)
+    return;
+  uint64_t prazo = r > 0 ? copia.prazo_us + r : agora_us - r;
+  for (int i = 0; i < ALARMES_MAX; ++i) {
+    if (!alarmes[i].id) {
+      alarmes[i] = copia;
+      alarmes[i].prazo_us = prazo;
+      return;
+    }
+  }
+}
+
+// Modelo do jardim ---------------------------------------------------------------------------------
+
+static double umidade[HAL_SIM_VASOS], reservatorio;
+static uint64_t modelo_us; // Instante até onde o modelo já foi integrado
+static bool nivel[32]; // Saídas digitais
+static uint32_t aleatorio = 12345;
+
+// 0 à noite, 1 com o sol a pino (dia das 6h às 18h)
+static double luz_ambiente(uint64_t t_us) {
+  double hora = fmod(cfg.hora_inicial + t_us / 3.6e9, 24.0);
+  double luz = sin(M_PI * (hora - 6.0) / 12.0);
+  return luz > 0 ? luz : 0;
+}
+
+// Integra em passos de até 1 s; os relés só mudam nas fronteiras, pois todo avanço do relógio passa por aqui
+static void modelo_ate(uint64_t t_us) {
+  while (modelo_us < t_us) {
+    uint64_t passo = t_us - modelo_us;
+    if (passo > 1000000)
+      passo = 1000000;
+    double dt = passo / 1e6;
+    double evaporacao = (cfg.evaporacao_pct_h + cfg.evaporacao_sol_pct_h * luz_ambiente(modelo_us)) * dt / 3600.0;
+    uint8_t ligados = 0;
+    for (uint8_t v = 0; v < cfg.vasos; ++v) {
+      umidade[v] -= evaporacao * (1 + 0.15 * v); // Vasos maiores ou mais expostos secam mais rápido
+      if (nivel[cfg.vaso[v].pino_rele]) {
+        ligados++;
+        if (reservatorio > 0) {
+          umidade[v] += cfg.ganho_pct_s * dt;
+          double volume = cfg.vazao_l_s * dt < reservatorio ? cfg.vazao_l_s * dt : reservatorio;
+          reservatorio -= volume;
+          est.bombeado_l += volume;
+        }
+      }
+      if (umidade[v] < 0)
+        umidade[v] = 0;
+      if (umidade[v] > 100)
+        umidade[v] = 100;
+      if (umidade[v] < est.umidade_min)
+        est.umidade_min = umidade[v];
+      if (umidade[v] > est.umidade_max)
+        est.umidade_max = umidade[v];
+    }
+    if (ligados && reservatorio <= 0)
+      est.bomba_seca_us += passo;
+    if (ligados > 1)
+      est.sobreposicao_us += passo;
+    modelo_us += passo;
+  }
+  est.reservatorio_l = reservatorio;
+}
+
+// Avança o relógio até t disparando, em ordem, os alarmes que vencem no caminho
+static void avancar(uint64_t t_us) {
+  alarme_t *a;
+  while ((a = alarme_mais_cedo()) && a->prazo_us <= t_us) {
+    if (a->prazo_us > agora_us) {
+      modelo_ate(a->prazo_us);
+      agora_us = a->prazo_us;
+    }
+    alarme_disparar(a);
+  }
+  if (t_us > agora_us) {
+    modelo_ate(t_us);
+    agora_us = t_us;
+  }
+}
+
+// Roteiro do ADC -----------------------------------------------------------------------------------
+
+typedef struct {
+  double *t_s, *valor;
+  size_t total, cursor;
+} roteiro_t;
+
+static roteiro_t roteiro[SENSORES_CANAIS];
+
+static bool roteiro_carregar(const char *arquivo) {
+  FILE *f = fopen(arquivo, "r");
+  if (!f)
+    return false;
+  char linha[128];
+  while (fgets(linha, sizeof linha, f)) {
+    double t, v;
+    unsigned canal;
+    if (linha[0] == '#' || sscanf(linha, "%lf %u %lf", &t, &canal, &v) != 3 || canal >= SENSORES_CANAIS)
+      continue;
+    roteiro_t *r = &roteiro[canal];
+    r->t_s = realloc(r->t_s, (r->total + 1) * sizeof(double));
+    r->valor = realloc(r->valor, (r->total + 1) * sizeof(double));
+    r->t_s[r->total] = t;
+    r->valor[r->total] = v;
+    r->total++;
+  }
+  fclose(f);
+  return true;
+}
+
+// Interpolação linear entre os pontos; antes do primeiro e depois do último o valor fica constante
+static double roteiro_valor(roteiro_t *r, double t) {
+  while (r->cursor + 1 < r->total && r->t_s[r->cursor + 1] <= t)
+    r->cursor++; // O tempo só avança: a busca continua de onde parou
+  if (t <= r->t_s[0] || r->cursor + 1 == r->total)
+    return r->valor[t <= r->t_s[0] ? 0 : r->cursor];
+  double t0 = r->t_s[r->cursor], t1 = r->t_s[r->cursor + 1];
+  double v0 = r->valor[r->cursor], v1 = r->valor[r->cursor + 1];
+  return v0 + (v1 - v0) * (t - t0) / (t1 - t0);
+}
+
+// SSD1306 emulado ----------------------------------------------------------------------------------
+
+#define I2C_US_POR_BYTE 22.5 // 9 bits por byte a 400 kHz
+
+static struct {
+  uint8_t ram[8][128];
+  uint8_t modo; // 0 = horizontal, 1 = vertical, 2 = página
+  uint8_t col, col_ini, col_fim, pag, pag_ini, pag_fim;
+  uint8_t cmd[8], cmd_total, cmd_esperado;
+  enum { CONTROLE, UM_BYTE, RESTANTE } fase;
+  bool dados; // Bit D/C do último byte de controle
+} oled;
+
+static uint64_t i2c_fim_us; // Fim da transferência em segundo plano
+
+static uint8_t oled_argumentos(uint8_t c) {
+  switch (c) {
+  case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+    return 1;
+  case 0x21: case 0x22: case 0xA3:
+    return 2;
+  case 0x29: case 0x2A:
+    return 5;
+  case 0x26: case 0x27:
+    return 6;
+  case 0x2C: case 0x2D:
+    return 7;
+  default:
+    return 0;
+  }
+}
+
+// Rolagem de uma coluna (0x2C direita, 0x2D esquerda): a coluna que sai por um lado entra pelo outro
+static void oled_rolar_coluna(uint8_t pag0, uint8_t pag1, uint8_t col0, uint8_t col1, bool esquerda) {
+  if (col0 >= col1)
+    return;
+  for (uint8_t p = pag0; p <= pag1; ++p) {
+    uint8_t *linha = oled.ram[p];
+    if (esquerda) {
+      uint8_t saiu = linha[col0];
+      memmove(&linha[col0], &linha[col0 + 1], col1 - col0);
+      linha[col1] = saiu;
+    } else {
+      uint8_t saiu = linha[col1];
+      memmove(&linha[col0 + 1], &linha[col0], col1 - col0);
+      linha[col0] = saiu;
+    }
+  }
+}
+
+static void oled_comando(uint8_t b) {
+  oled.cmd[oled.cmd_total++] = b;
+  if (oled.cmd_total == 1)
+    oled.cmd_esperado = 1 + oled_argumentos(b);
+  if (oled.cmd_total < oled.cmd_esperado)
+    return;
+  uint8_t *c = oled.cmd;
+  oled.cmd_total = 0;
+  if (c[0] == 0x20) {
+    oled.modo = c[1] & 3;
+  } else if (c[0] == 0x21) {
+    oled.col = oled.col_ini = c[1] & 0x7F;
+    oled.col_fim = c[2] & 0x7F;
+  } else if (c[0] == 0x22) {
+    oled.pag = oled.pag_ini = c[1] & 7;
+    oled.pag_fim = c[2] & 7;
+  } else if (c[0] == 0x2C || c[0] == 0x2D) {
+    oled_rolar_coluna(c[2] & 7, c[4] & 7, c[6] & 0x7F, c[7] & 0x7F, c[0] == 0x2D);
+  } else if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+    oled.pag = c[0] & 7;
+  } else if (c[0] <= 0x0F) {
+    oled.col = (oled.col & 0xF0) | c[0];
+  } else if (c[0] <= 0x1F) {
+    oled.col = (oled.col & 0x0F) | ((c[0] & 0x07) << 4);
+  }
+}
+
+static void oled_dado(uint8_t b) {
+  oled.ram[oled.pag][oled.col] = b;
+  if (oled.modo == 1) {
+    if (++oled.pag > oled.pag_fim) {
+      oled.pag = oled.pag_ini;
+      if (++oled.col > oled.col_fim)
+        oled.col = oled.col_ini;
+    }
+  } else if (oled.modo == 0) {
+    if (++oled.col > oled.col_fim) {
+      oled.col = oled.col_ini;
+      if (++oled.pag > oled.pag_fim)
+        oled.pag = oled.pag_ini;
+    }
+  } else if (oled.col < 127) {
+    oled.col++;
+  }
+}
+
+// Cada transação começa por um byte de controle: Co = 0x80 (só um byte a seguir), D/C = 0x40 (dados)
+static void oled_byte(uint8_t b) {
+  switch (oled.fase) {
+  case CONTROLE:
+    oled.dados = b & 0x40;
+    oled.fase = (b & 0x80) ? UM_BYTE : RESTANTE;
+    return;
+  case UM_BYTE:
+    oled.fase = CONTROLE;
+    break;
+  case RESTANTE:
+    break;
+  }
+  if (oled.dados)
+    oled_dado(b);
+  else
+    oled_comando(b);
+}
+
+// ADS1115 emulado: registrador de configuração (conversão única, MUX = 4 + canal) e de conversão.
+// A conversão fica pronta na hora; o barramento é o i2c0, fora da contabilidade do display.
+
+static struct {
+  uint8_t ponteiro;
+  int16_t resultado;
+} ads;
+
+static void ads_escrever(const uint8_t *dados, size_t total) {
+  if (!total)
+    return;
+  ads.ponteiro = dados[0] & 3;
+  if (ads.ponteiro != 1 || total < 3 || !(dados[1] & 0x80))
+    return;
+  int8_t canal = ((dados[1] >> 4) & 7) - 4;
+  ads.resultado = 0;
+  for (uint8_t v = 0; v < cfg.vasos; ++v)
+    if (canal >= 0 && cfg.vaso[v].canal_i2c == canal)
+      ads.resultado = (int16_t)(umidade[v] / 100.0 * ZONAS_I2C_3V3);
+}
+
+static uint64_t i2c_contabilizar(size_t bytes, uint32_t transacoes) {
+  est.i2c_bytes += bytes;
+  est.i2c_transacoes += transacoes;
+  uint64_t duracao = (uint64_t)((bytes + transacoes) * I2C_US_POR_BYTE); // + byte de endereço
+  est.i2c_ocupado_us += duracao;
+  return duracao;
+}
+
+// Flash emulada: apagar põe 0xFF, programar só leva bits de 1 para 0, como na memória NOR real.
+// As duas operações param o laço que grava e o do núcleo 0, mas os alarmes (na RAM no firmware,
+// ver hal_flash_pausavel) continuam disparando no horário.
+
+#define FLASH_APAGAR_US 45000
+#define FLASH_PROGRAMAR_US 1000
+
+static uint8_t flash[PICO_FLASH_SIZE_BYTES];
+
+static void parar_cpu(uint64_t duracao_us) {
+  avancar(agora_us + duracao_us);
+}
+
+// UART da rede emulada -----------------------------------------------------------------------------
+// Os quadros chegam inteiros, entregues pelo barramento simulado no instante do último byte (como a
+// interrupção de linha parada da UART); o envio sai pelo gancho conectado e bloqueia pelo tempo dos bytes.
+
+#define UART_FILA 1024
+
+static struct {
+  uint8_t b;
+  uint64_t t_us;
+} uart_fila[UART_FILA];
+static uint32_t uart_cabeca, uart_cauda, uart_baud = 115200;
+static hal_sim_uart_saida_t uart_saida;
+
+static uint64_t uart_chegada_us(void) {
+  return uart_cauda != uart_cabeca ? uart_fila[uart_cauda % UART_FILA].t_us : UINT64_MAX;
+}
+
+// Entrada da serial USB: linhas digitadas pela simulação (hal_sim_serial_digitar), cada caractere
+// visível a partir do seu instante de chegada
+#define SERIAL_FILA 1024
+
+static struct {
+  char c;
+  uint64_t t_us;
+} serial_fila[SERIAL_FILA];
+static uint32_t serial_cabeca, serial_cauda;
+
+// Linha do tempo -----------------------------------------------------------------------------------
+
+static void registrar(const char *sinal, unsigned valor) {
+  if (cfg.linha_do_tempo)
+    fprintf(cfg.linha_do_tempo, "%.3f,%s,%u\n", agora_us / 1e6, sinal, valor);
+}
+
+// Controle da simulação ----------------------------------------------------------------------------
+
+void hal_sim_config_padrao(hal_sim_config_t *c) {
+  *c = (hal_sim_config_t){
+    .vasos = 1,
+    .vaso = {{12, -1, -1}},
+    .pinos_mux = {ZONAS_MUX_PINO_A, ZONAS_MUX_PINO_B, ZONAS_MUX_PINO_C},
+    .endereco_i2c = ZONAS_I2C_ENDERECO,
+    .pino_buzzer = 21,
+    .umidade_inicial = 45,
+    .evaporacao_pct_h = 0.5,
+    .evaporacao_sol_pct_h = 3.0,
+    .ganho_pct_s = 3.0,
+    .vazao_l_s = 0.05,
+    .reservatorio_l = 10,
+    .pino_nivel = -1,
+    .nivel_min_l = 0.5,
+    .pulsos_por_litro = AGUA_PULSOS_POR_LITRO,
+    .hora_inicial = 8,
+    .canal_defeito = -1,
+  };
+}
+
+bool hal_sim_iniciar(const hal_sim_config_t *c) {
+  cfg = *c;
+  memset(&est, 0, sizeof est);
+  memset(alarmes, 0, sizeof alarmes);
+  memset(&oled, 0, sizeof oled);
+  memset(&ads, 0, sizeof ads);
+  memset(flash, 0xFF, sizeof flash);
+  oled.col_fim = 127;
+  oled.pag_fim = 7;
+  uint32_t lixo = 1;
+  for (int p = 0; p < 8; ++p) // Memória do display com lixo na partida, como no hardware
+    for (int x = 0; x < 128; ++x)
+      oled.ram[p][x] = (lixo = lixo * 1103515245u + 12345u) >> 24;
+  agora_us = modelo_us = i2c_fim_us = 0;
+  uart_cabeca = uart_cauda = 0;
+  uart_saida = NULL;
+  serial_cabeca = serial_cauda = 0;
+  est.umidade_min = est.umidade_max = cfg.umidade_inicial;
+  for (uint8_t v = 0; v < cfg.vasos; ++v) {
+    umidade[v] = cfg.umidade_inicial - 3 * v;
+    if (umidade[v] < est.umidade_min)
+      est.umidade_min = umidade[v];
+  }
+  reservatorio = est.reservatorio_l = cfg.reservatorio_l;
+  if (cfg.linha_do_tempo)
+    fprintf(cfg.linha_do_tempo, "t_s,sinal,valor\n");
+  return !cfg.roteiro || roteiro_carregar(cfg.roteiro);
+}
+
+const hal_sim_estatisticas_t *hal_sim_estatisticas(void) {
+  return &est;
+}
+
+double hal_sim_umidade(uint8_t vaso) {
+  return umidade[vaso];
+}
+
+bool hal_sim_salvar_oled(const char *arquivo) {
+  FILE *f = fopen(arquivo, "w");
+  if (!f)
+    return false;
+  fprintf(f, "P1\n128 64\n");
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 128; ++x)
+      fputc(oled.ram[y >> 3][x] & (1 << (y & 7)) ? '1' : '0', f);
+    fputc('\n', f);
+  }
+  return fclose(f) == 0;
+}
+
+uint32_t hal_sim_oled_diferencas(const uint8_t *ram_buffer) {
+  uint32_t n = 0;
+  for (int x = 0; x < 128; ++x)
+    for (int p = 0; p < 8; ++p)
+      n += oled.ram[p][x] != ram_buffer[(x << 3) + p];
+  return n;
+}
+
+bool hal_sim_carregar_flash(const char *arquivo) {
+  FILE *f = fopen(arquivo, "rb");
+  if (!f)
+    return false;
+  size_t lidos = fread(flash, 1, sizeof flash, f);
+  fclose(f);
+  return lidos == sizeof flash;
+}
+
+bool hal_sim_salvar_flash(const char *arquivo) {
+  FILE *f = fopen(arquivo, "wb");
+  if (!f)
+    return false;
+  size_t escritos = fwrite(flash, 1, sizeof flash, f);
+  return fclose(f) == 0 && escritos == sizeof flash;
+}
+
+void hal_sim_espera_ativa(void) {
+  avancar(agora_us + 1);
+}
+
+// HAL ----------------------------------------------------------------------------------------------
+
+uint64_t hal_tempo_us(void) {
+  return agora_us;
+}
+
+// Um quadro chegando pela UART é uma interrupção: acorda antes do prazo, mesmo que tenha sido
+// entregue por um alarme no meio do sono
+void hal_dormir_ate(uint64_t prazo_us) {
+  do {
+    uint64_t ate = uart_chegada_us() < prazo_us ? uart_chegada_us() : prazo_us;
+    alarme_t *a = alarme_mais_cedo();
+    avancar(a && a->prazo_us < ate ? a->prazo_us : ate);
+  } while (agora_us < prazo_us && !hal_uart_pendente());
+}
+
+// Sem outra thread para acordar a CPU, "dormir" é pular até o próximo alarme
+void hal_dormir(void) {
+  alarme_t *a = alarme_mais_cedo();
+  hal_dormir_ate(a ? a->prazo_us : agora_us + 1000);
+}
+
+// No host os "ciclos" são nanossegundos reais (CLOCK_MONOTONIC): medem o código, não o relógio virtual
+uint32_t hal_ciclos(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000000u + (uint32_t)ts.tv_nsec;
+}
+
+uint32_t hal_ciclos_decorridos(uint32_t inicio) {
+  return hal_ciclos() - inicio;
+}
+
+uint32_t hal_ciclos_por_us(void) {
+  return 1000;
+}
+
+void hal_barreira(void) {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void hal_sinalizar(void) {
+}
+
+uint32_t hal_trava(void) {
+  return 0; // Os alarmes só disparam dentro de avancar, nunca no meio de uma seção crítica
+}
+
+void hal_destrava(uint32_t estado) {
+  (void)estado;
+}
+
+void hal_gpio_saida(uint pino) {
+  nivel[pino] = false;
+}
+
+void hal_gpio_put(uint pino, bool valor) {
+  if (nivel[pino] == valor)
+    return;
+  modelo_ate(agora_us);
+  nivel[pino] = valor;
+  for (uint8_t v = 0; v < cfg.vasos; ++v) {
+    if (pino == cfg.vaso[v].pino_rele) {
+      char sinal[8];
+      snprintf(sinal, sizeof sinal, "rele%u", v + 1);
+      est.acionamentos_rele += valor;
+      registrar(sinal, valor);
+    }
+  }
+}
+
+bool hal_gpio_get(uint pino) {
+  if ((int)pino == cfg.pino_nivel)
+    return reservatorio < cfg.nivel_min_l; // Boia aberta: pull-up em alto
+  return nivel[pino];
+}
+
+void hal_gpio_entrada(uint pino) {
+}
+
+// O sensor de vazão conta a água que saiu do reservatório; com ele vazio a bomba gira a seco e não
+// há pulsos
+void hal_fluxo_init(uint pino) {
+}
+
+uint32_t hal_fluxo_pulsos(void) {
+  return (uint32_t)(est.bombeado_l * cfg.pulsos_por_litro);
+}
+
+hal_alarme_t hal_alarme_em_ms(uint32_t ms, hal_alarme_fn_t fn, void *ctx) {
+  return alarme_inserir(agora_us + ms * 1000ull, fn, ctx);
+}
+
+bool hal_alarme_cancelar(hal_alarme_t id) {
+  for (int i = 0; i < ALARMES_MAX; ++i) {
+    if (alarmes[i].id == id) {
+      alarmes[i].id = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint16_t hal_adc_ler(uint8_t canal) {
+  static uint16_t preso; // Leitura em que o canal com defeito travou
+  static bool travado;
+  if (canal == cfg.canal_defeito && agora_us >= cfg.defeito_s * 1e6) {
+    if (cfg.defeito == 's')
+      return 4095; // Fio solto: só o pull-up, sem ruído
+    if (travado)
+      return preso;
+  }
+  double v;
+  if (canal < SENSORES_CANAIS && roteiro[canal].total) {
+    v = roteiro_valor(&roteiro[canal], agora_us / 1e6);
+  } else if (canal == SENSOR_CANAL_UMIDADE) {
+    v = cfg.vasos ? umidade[0] * 40.95 : 0;
+  } else if (canal == SENSOR_CANAL_MUX) {
+    int8_t selecionado = nivel[cfg.pinos_mux[0]] | nivel[cfg.pinos_mux[1]] << 1 | nivel[cfg.pinos_mux[2]] << 2;
+    v = 0; // Canal sem vaso: entrada aterrada
+    for (uint8_t i = 0; i < cfg.vasos; ++i)
+      if (cfg.vaso[i].canal_mux == selecionado)
+        v = umidade[i] * 40.95;
+  } else if (canal == SENSOR_CANAL_TEMPERATURA) {
+    v = 876; // 0,706 V: 27 °C
+  } else
+    v = 3900 - 3600 * luz_ambiente(agora_us); // LDR: leitura alta no escuro
+  aleatorio = aleatorio * 1103515245u + 12345u;
+  v += (int)((aleatorio >> 16) % 7) - 3; // Ruído residual de +-3 contagens após a média
+  uint16_t leitura = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)v;
+  if (canal == cfg.canal_defeito && agora_us >= cfg.defeito_s * 1e6) {
+    preso = leitura;
+    travado = true;
+  }
+  return leitura;
+}
+
+bool hal_i2c_escrever(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t total) {
+  if (endereco == cfg.endereco_i2c) {
+    if (!cfg.vasos)
+      return false;
+    ads_escrever(dados, total);
+    hal_dormir_ate(agora_us + (uint64_t)((total + 1) * I2C_US_POR_BYTE));
+    return true;
+  }
+  oled.fase = CONTROLE;
+  for (size_t i = 0; i < total; ++i)
+    oled_byte(dados[i]);
+  hal_dormir_ate(agora_us + i2c_contabilizar(total, 1)); // Escrita bloqueante: a CPU espera o barramento
+  return true;
+}
+
+bool hal_i2c_ler(i2c_inst_t *i2c, uint8_t endereco, uint8_t *dados, size_t total) {
+  if (endereco != cfg.endereco_i2c || !cfg.vasos)
+    return false;
+  uint16_t r = ads.ponteiro == 0 ? (uint16_t)ads.resultado : 0;
+  for (size_t i = 0; i < total; ++i)
+    dados[i] = i == 0 ? r >> 8 : i == 1 ? r & 0xFF : 0;
+  est.leituras_i2c++;
+  hal_dormir_ate(agora_us + (uint64_t)((total + 1) * I2C_US_POR_BYTE));
+  return true;
+}
+
+// O conteúdo é aplicado na hora; o barramento fica ocupado pelo tempo que a transferência levaria
+void hal_i2c_dma(i2c_inst_t *i2c, uint8_t endereco, const uint16_t *palavras, size_t total) {
+  uint32_t transacoes = 0;
+  oled.fase = CONTROLE;
+  for (size_t i = 0; i < total; ++i) {
+    oled_byte(palavras[i] & 0xFF);
+    if (palavras[i] & HAL_I2C_STOP) {
+      oled.fase = CONTROLE;
+      transacoes++;
+    }
+  }
+  i2c_fim_us = agora_us + i2c_contabilizar(total, transacoes);
+}
+
+bool hal_i2c_ocupado(i2c_inst_t *i2c) {
+  return agora_us < i2c_fim_us;
+}
+
+// Só o tempo de linha: uma palavra do FIFO leva um LED (programa matriz) ou quatro bits de LED de
+// todas as fitas (matriz_paralelo), 10 ciclos de 8 MHz por bit
+static uint8_t leds_fitas;
+static uint64_t leds_fim_us;
+
+void hal_leds_init(uint pino, uint8_t fitas) {
+  leds_fitas = fitas;
+}
+
+void hal_leds_enviar(const uint32_t *palavras, uint total) {
+  uint64_t duracao = (uint64_t)total * (leds_fitas > 1 ? 4 : 24) * 5 / 4;
+  est.quadros_leds++;
+  est.leds_ocupado_us += duracao;
+  leds_fim_us = agora_us + duracao;
+}
+
+bool hal_leds_ocupado(void) {
+  return agora_us < leds_fim_us;
+}
+
+void hal_pwm_init(uint pino) {
+}
+
+void hal_pwm_tom(uint pino, uint16_t freq_hz) {
+  static uint16_t atual;
+  if (pino != cfg.pino_buzzer || freq_hz == atual)
+    return;
+  atual = freq_hz;
+  est.tons_buzzer += freq_hz != 0;
+  registrar("buzzer", freq_hz);
+}
+
+void hal_flash_pausavel(void) {
+}
+
+void hal_flash_apagar(uint32_t deslocamento) {
+  memset(&flash[deslocamento], 0xFF, HAL_FLASH_SETOR);
+  est.flash_apagamentos++;
+  parar_cpu(FLASH_APAGAR_US);
+}
+
+void hal_flash_programar(uint32_t deslocamento, const uint8_t *pagina) {
+  for (uint32_t i = 0; i < HAL_FLASH_PAGINA; ++i)
+    flash[deslocamento + i] &= pagina[i];
+  est.flash_programacoes++;
+  parar_cpu(FLASH_PROGRAMAR_US);
+}
+
+const uint8_t *hal_flash_ler(uint32_t deslocamento) {
+  return &flash[deslocamento];
+}
+
+int hal_serial_ler(void) {
+  if (serial_cauda == serial_cabeca || serial_fila[serial_cauda % SERIAL_FILA].t_us > agora_us)
+    return -1;
+  return (uint8_t)serial_fila[serial_cauda++ % SERIAL_FILA].c;
+}
+
+bool hal_sim_serial_digitar(const char *texto, uint64_t chegada_us) {
+  size_t total = strlen(texto);
+  if (total > SERIAL_FILA - (serial_cabeca - serial_cauda))
+    return false;
+  for (size_t i = 0; i < total; ++i, ++serial_cabeca) {
+    serial_fila[serial_cabeca % SERIAL_FILA].c = texto[i];
+    serial_fila[serial_cabeca % SERIAL_FILA].t_us = chegada_us;
+  }
+  return true;
+}
+
+size_t hal_serial_livre(void) {
+  return 4096; // Um arquivo nunca enche
+}
+
+void hal_serial_escrever_bruto(const uint8_t *dados, size_t total) {
+  fwrite(dados, 1, total, stdout);
+}
+
+void hal_uart_init(uint32_t baud, uint pino_tx, uint pino_rx, uint pino_de) {
+  uart_baud = baud;
+}
+
+bool hal_uart_pendente(void) {
+  return uart_chegada_us() <= agora_us;
+}
+
+size_t hal_uart_ler(uint8_t *dados, size_t max) {
+  size_t n = 0;
+  for (; n < max && hal_uart_pendente(); ++uart_cauda)
+    dados[n++] = uart_fila[uart_cauda % UART_FILA].b;
+  return n;
+}
+
+void hal_uart_enviar(const uint8_t *dados, size_t total) {
+  if (uart_saida)
+    uart_saida(dados, total, agora_us);
+  avancar(agora_us + total * 10000000ull / uart_baud); // 10 bits por byte (8N1); os alarmes continuam
+}
+
+void hal_sim_uart_conectar(hal_sim_uart_saida_t saida) {
+  uart_saida = saida;
+}
+
+void hal_sim_uart_entregar(const uint8_t *dados, size_t total, uint64_t chegada_us) {
+  for (size_t i = 0; i < total && uart_cabeca - uart_cauda < UART_FILA; ++i, ++uart_cabeca) {
+    uart_fila[uart_cabeca % UART_FILA].b = dados[i];
+    uart_fila[uart_cabeca % UART_FILA].t_us = chegada_us;
+  }
+}
+
+uint8_t hal_sim_reles_ligados(void) {
+  uint8_t n = 0;
+  for (uint8_t v = 0; v < cfg.vasos; ++v)
+    n += nivel[cfg.vaso[v].pino_rele];
+  return n;
+}
+
+void hal_relogio_economia(bool economia) {
+  est.trocas_relogio++;
+}
+
+void hal_i2c_init(i2c_inst_t *i2c, uint32_t baud) {
+}
@@ -0,0 +1,75 @@
+// Controles da implementação de host da HAL: relógio virtual, modelo do jardim (vasos, luz,
+// reservatório), roteiro de leituras do ADC e captura do display, dos relés e do buzzer
+#ifndef HAL_LINUX_H
+#define HAL_LINUX_H
+
+#include <stdio.h>
+#include "hal.h"
+
+#define HAL_SIM_VASOS 8
+
+// Fiação dos vasos: o vaso 0 fica no canal SENSOR_CANAL_UMIDADE do ADC; os demais num canal do
+// multiplexador (seleção nos pinos_mux, saída em SENSOR_CANAL_MUX) ou do ADS1115 emulado no i2c0
+typedef struct {
+  uint8_t pino_rele;
+  int8_t canal_mux, canal_i2c; // -1 = não ligado nessa fonte
+} hal_sim_vaso_t;
+
+typedef struct {
+  uint8_t vasos;
+  hal_sim_vaso_t vaso[HAL_SIM_VASOS];
+  uint8_t pinos_mux[3]; // Seleção A, B e C
+  uint8_t endereco_i2c; // ADS1115
+  uint8_t pino_buzzer; // Registrado na linha do tempo, com os relés
+  double umidade_inicial; // Umidade do solo no início (%); os vasos seguintes começam um pouco mais secos
+  double evaporacao_pct_h; // Perda de umidade à noite (%/h); cada vaso perde um pouco mais que o anterior
+  double evaporacao_sol_pct_h; // Perda adicional com sol a pino (%/h)
+  double ganho_pct_s; // Ganho de umidade com o relé do vaso ligado (%/s)
+  double vazao_l_s; // Vazão da bomba (L/s)
+  double reservatorio_l; // Água disponível no início (L)
+  int8_t pino_nivel; // Boia do reservatório: alto abaixo de nivel_min_l (-1 = sem boia)
+  double nivel_min_l;
+  uint16_t pulsos_por_litro; // Sensor de vazão na saída da bomba
+  double hora_inicial; // Hora do dia em t = 0 (0-24)
+  int8_t canal_defeito; // Canal do ADC com defeito a partir de defeito_s (-1 = nenhum)
+  char defeito; // 'p' = preso na leitura daquele instante, 's' = solto (pull-up: 4095)
+  double defeito_s;
+  const char *roteiro; // Arquivo "t_s canal valor" que substitui o modelo nos canais citados (NULL = só modelo)
+  FILE *linha_do_tempo; // CSV "t_s,sinal,valor" com as mudanças dos relés e do buzzer (NULL = desligado)
+} hal_sim_config_t;
+
+typedef struct {
+  double umidade_min, umidade_max; // Umidade real do solo no modelo (%), entre todos os vasos
+  double reservatorio_l; // Água restante
+  double bombeado_l; // Água que passou pelo sensor de vazão
+  uint64_t bomba_seca_us; // Tempo com algum relé ligado e o reservatório vazio
+  uint64_t sobreposicao_us; // Tempo com mais de um relé ligado ao mesmo tempo
+  uint32_t leituras_i2c;
+  uint32_t acionamentos_rele, tons_buzzer;
+  uint64_t i2c_bytes, i2c_ocupado_us;
+  uint32_t i2c_transacoes;
+  uint32_t quadros_leds;
+  uint64_t leds_ocupado_us; // Tempo total transmitindo para as fitas WS2812 (1,25 us por bit de LED)
+  uint32_t alarmes_disparados;
+  uint32_t flash_apagamentos, flash_programacoes;
+  uint32_t trocas_relogio;
+} hal_sim_estatisticas_t;
+
+void hal_sim_config_padrao(hal_sim_config_t *cfg);
+bool hal_sim_iniciar(const hal_sim_config_t *cfg); // false se o roteiro não puder ser lido
+const hal_sim_estatisticas_t *hal_sim_estatisticas(void);
+double hal_sim_umidade(uint8_t vaso); // Umidade real do solo no modelo (%)
+bool hal_sim_salvar_oled(const char *arquivo); // Memória do SSD1306 emulado em PBM (P1)
+uint32_t hal_sim_oled_diferencas(const uint8_t *ram_buffer); // Bytes da memória emulada diferentes do buffer do driver
+bool hal_sim_carregar_flash(const char *arquivo); // Imagem da flash inteira (ajustes, histórico): simula um reinício
+bool hal_sim_salvar_flash(const char *arquivo);
+uint8_t hal_sim_reles_ligados(void); // Relés dos vasos ligados agora
+bool hal_sim_serial_digitar(const char *texto, uint64_t chegada_us); // Entrada da serial USB, em ordem de chegada; false sem espaço
+
+// UART da rede: saida recebe cada envio do firmware com o instante do primeiro bit; entregar põe um
+// quadro na recepção, visível (e acordando o firmware) a partir de chegada_us
+typedef void (*hal_sim_uart_saida_t)(const uint8_t *dados, size_t total, uint64_t inicio_us);
+void hal_sim_uart_conectar(hal_sim_uart_saida_t saida); // Depois de hal_sim_iniciar
+void hal_sim_uart_entregar(const uint8_t *dados, size_t total, uint64_t chegada_us);
+
+#endif
@@ -0,0 +1,130 @@
+// Decodifica o histórico exportado por registro_exportar (Include/registro.c) em CSV.
+//
+//   ./ler_registro /dev/ttyACM0 > historico.csv   # envia "D" para a placa e lê a resposta
+//   ./ler_registro registro.bin > historico.csv   # arquivo já exportado (ex.: sim_garden --registro)
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+#include "registro.h"
+#include "fixo.h"
+
+static FILE *entrada;
+
+static int byte(void) {
+  int c = fgetc(entrada);
+  if (c == EOF) {
+    fprintf(stderr, "fim inesperado da exportação\n");
+    exit(1);
+  }
+  return c;
+}
+
+static uint32_t varint(const uint8_t *p, uint16_t *pos) {
+  uint32_t v = 0;
+  for (uint8_t desloc = 0; desloc < 35; desloc += 7) {
+    uint8_t b = p[(*pos)++];
+    v |= (uint32_t)(b & 0x7F) << desloc;
+    if (!(b & 0x80))
+      break;
+  }
+  return v;
+}
+
+static int32_t varint_sinal(const uint8_t *p, uint16_t *pos) {
+  uint32_t v = varint(p, pos);
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// Abre o dispositivo serial em modo bruto e pede a exportação; arquivos comuns são lidos direto
+static FILE *abrir(const char *caminho) {
+  struct stat st;
+  if (stat(caminho, &st) || !S_ISCHR(st.st_mode))
+    return fopen(caminho, "rb");
+  int fd = open(caminho, O_RDWR | O_NOCTTY);
+  if (fd < 0)
+    return NULL;
+  struct termios t;
+  if (!tcgetattr(fd, &t)) {
+    cfmakeraw(&t);
+    t.c_cc[VMIN] = 1;
+    t.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &t);
+  }
+  tcflush(fd, TCIFLUSH);
+  if (write(fd, "D", 1) != 1)
+    return NULL;
+  return fdopen(fd, "rb");
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "uso: %s <dispositivo serial | arquivo exportado>\n", argv[0]);
+    return 2;
+  }
+  if (!(entrada = abrir(argv[1]))) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // Quadros de telemetria e texto podem vir antes: procura o início da exportação byte a byte
+  static const char inicio[] = "REGISTRO ";
+  int versao = -1;
+  size_t casados = 0;
+  int c;
+  while (casados < sizeof inicio - 1 && (c = fgetc(entrada)) != EOF)
+    casados = c == inicio[casados] ? casados + 1 : c == inicio[0];
+  if (casados == sizeof inicio - 1 && fscanf(entrada, "%d", &versao) == 1)
+    byte(); // \n
+  if (versao != REGISTRO_VERSAO) {
+    fprintf(stderr, "exportação não encontrada ou versão %d não suportada\n", versao);
+    return 1;
+  }
+
+  static const char *const alertas[] = {"nenhum", "verificando", "cancelado", "tocando", "desligado", "sensor"};
+  printf("boot,t_s,zona,luz_adc,umidade_adc,umidade_pct,rele,alerta\n");
+  uint8_t setor[HAL_FLASH_SETOR];
+  uint32_t setores = 0, amostras = 0, bytes = 0;
+  uint8_t paginas;
+  while ((paginas = byte()) != 0) {
+    if (paginas > HAL_FLASH_SETOR / HAL_FLASH_PAGINA || fread(setor, HAL_FLASH_PAGINA, paginas, entrada) != paginas) {
+      fprintf(stderr, "setor %u truncado\n", setores);
+      return 1;
+    }
+    registro_cabecalho_t c;
+    memcpy(&c, setor, sizeof c);
+    if (c.magico != REGISTRO_MAGICO || c.versao < 1 || c.versao > REGISTRO_VERSAO)
+      continue;
+    setores++;
+    bytes += paginas * HAL_FLASH_PAGINA;
+
+    uint32_t t = c.t0;
+    int32_t luz = 0, umidade[ZONAS_MAX] = {0}; // Referências por zona, como em registro_adicionar
+    for (uint8_t p = 0; p < paginas; ++p) {
+      const uint8_t *pagina = &setor[p * HAL_FLASH_PAGINA];
+      uint16_t pos = p == 0 ? sizeof c : 0;
+      // Registros nunca atravessam páginas; a página termina no primeiro 0xFF
+      while (pos < HAL_FLASH_PAGINA && pagina[pos] != 0xFF) {
+        uint8_t cab = pagina[pos++];
+        t += varint(pagina, &pos);
+        luz += varint_sinal(pagina, &pos);
+        uint8_t zona = (cab >> 4) & 7;
+        umidade[zona] += varint_sinal(pagina, &pos);
+        uint8_t alerta = (cab >> 1) & 7;
+        printf("%u,%.1f,%u,%d,", c.boot, t / 10.0, zona + 1, luz);
+        if (umidade[zona] == ZONA_SEM_LEITURA)
+          printf(",,"); // Zona sem leitura
+        else
+          printf("%d,%.1f,", umidade[zona], adc_para_pct_q8(umidade[zona]) / 256.0);
+        printf("%d,%s\n", cab & 1, alerta < 6 ? alertas[alerta] : "?");
+        amostras++;
+      }
+    }
+  }
+  fprintf(stderr, "%u amostras em %u setores (%u bytes de flash, %.1f por amostra)\n",
+          amostras, setores, bytes, amostras ? (double)bytes / amostras : 0.0);
+  return 0;
+}
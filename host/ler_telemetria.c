@@ -0,0 +1,119 @@
+// Decodifica a telemetria binária do firmware (Include/telemetria.h) em CSV.
+//
+//   ./ler_telemetria /dev/ttyACM0 > telemetria.csv   # lê a placa até Ctrl+C
+//   ./ler_telemetria telemetria.bin > telemetria.csv # saída gravada (ex.: sim_garden --telemetria)
+//
+// O texto que chega entre os quadros (relatórios periódicos) vai para a saída de erro.
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+#include "telemetria.h"
+#include "quadro.h"
+
+#define MAX_QUADRO QUADRO_MAX(TELEMETRIA_CABECALHO + TELEMETRIA_LOTE * TELEMETRIA_AMOSTRA)
+
+// Dispositivos seriais em modo bruto; arquivos comuns são lidos direto
+static FILE *abrir(const char *caminho) {
+  struct stat st;
+  if (stat(caminho, &st) || !S_ISCHR(st.st_mode))
+    return fopen(caminho, "rb");
+  int fd = open(caminho, O_RDONLY | O_NOCTTY);
+  if (fd < 0)
+    return NULL;
+  struct termios t;
+  if (!tcgetattr(fd, &t)) {
+    cfmakeraw(&t);
+    t.c_cc[VMIN] = 1;
+    t.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &t);
+  }
+  return fdopen(fd, "rb");
+}
+
+static uint16_t le16(const uint8_t *p) {
+  return p[0] | p[1] << 8;
+}
+
+static uint32_t quadros, amostras, corrompidos, perdidos;
+static int32_t proxima_sequencia = -1;
+
+// Imprime as amostras de um quadro; false se o trecho não for um quadro válido
+static bool quadro(const uint8_t *q, size_t total) {
+  static const char *const alertas[] = {"nenhum", "verificando", "cancelado", "tocando", "desligado", "sensor"};
+  static const char *const telas[] = {"ligada", "escurecida", "apagada", "?"};
+  uint8_t c[MAX_QUADRO];
+  if (total > MAX_QUADRO)
+    return false;
+  int n = quadro_abrir(q, total, c);
+  if (n < TELEMETRIA_CABECALHO || c[0] != TELEMETRIA_VERSAO || n != TELEMETRIA_CABECALHO + c[7] * TELEMETRIA_AMOSTRA)
+    return false;
+  uint16_t sequencia = le16(&c[1]);
+  if (proxima_sequencia >= 0)
+    perdidos += (uint16_t)(sequencia - proxima_sequencia);
+  proxima_sequencia = (uint16_t)(sequencia + 1);
+  uint32_t t0 = le16(&c[3]) | (uint32_t)le16(&c[5]) << 16;
+  for (uint8_t i = 0; i < c[7]; ++i) {
+    const uint8_t *a = &c[TELEMETRIA_CABECALHO + i * TELEMETRIA_AMOSTRA];
+    uint8_t alerta = (a[9] >> 1) & 7;
+    printf("%u,%.3f,%u,%u,", sequencia, (t0 + le16(&a[0])) / 1000.0, a[2] + 1, le16(&a[3]));
+    if (le16(&a[7]) == 0xFFFF)
+      printf(",,"); // Zona sem leitura
+    else
+      printf("%u,%.1f,", le16(&a[5]), le16(&a[7]) / 256.0);
+    printf("%d,%s,%s,%d,%d\n", a[9] & 1, alerta < 6 ? alertas[alerta] : "?", telas[(a[9] >> 4) & 3],
+           (int8_t)a[10], (int8_t)a[11]);
+    amostras++;
+  }
+  quadros++;
+  return true;
+}
+
+static bool texto(const uint8_t *t, size_t total) {
+  for (size_t i = 0; i < total; ++i)
+    if (t[i] < ' ' && t[i] != '\n' && t[i] != '\r')
+      return false;
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "uso: %s <dispositivo serial | arquivo gravado>\n", argv[0]);
+    return 2;
+  }
+  FILE *entrada = abrir(argv[1]);
+  if (!entrada) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  printf("sequencia,t_s,zona,luz_adc,umidade_adc,umidade_pct,rele,alerta,tela,ideal,tempo_rega\n");
+  // Trechos entre zeros: quadros COBS ou o texto dos relatórios periódicos
+  bool ao_vivo = isatty(fileno(entrada));
+  uint8_t trecho[4096];
+  size_t n = 0;
+  int c;
+  while ((c = fgetc(entrada)) != EOF) {
+    if (c) {
+      if (n < sizeof trecho)
+        trecho[n++] = c;
+      continue;
+    }
+    if (n && !quadro(trecho, n)) {
+      if (texto(trecho, n))
+        fwrite(trecho, 1, n, stderr);
+      else
+        corrompidos++;
+    }
+    n = 0;
+    if (ao_vivo)
+      fflush(stdout);
+  }
+  if (n && texto(trecho, n))
+    fwrite(trecho, 1, n, stderr);
+  fprintf(stderr, "%u amostras em %u quadros, %u quadros corrompidos, %u perdidos (lacunas na sequência)\n",
+          amostras, quadros, corrompidos, perdidos);
+  return 0;
+}
@@ -0,0 +1,20 @@
+// Subconjunto mínimo do pico/stdlib.h para compilar os módulos do firmware no host (Linux)
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024) // Mesma flash da placa (BitDogLab / Pico W)
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f // Não há flash: tudo já roda da RAM
+
+// Uma espera ativa consome tempo: no host ela avança o relógio virtual (ver hal_linux.c)
+void hal_sim_espera_ativa(void);
+static inline void tight_loop_contents(void) { hal_sim_espera_ativa(); }
+
+#endif
@@ -0,0 +1,398 @@
+// Simulação do Garden mais rápida que o tempo real: a mesma lógica do firmware (jardim, irrigacao,
+// agenda, buzzer, ssd1306, matriz_leds) sobre hal_linux.c, com relógio virtual e modelo do jardim.
+//
+//   ./sim_garden --dias 7 --reservatorio 2 --linha-do-tempo rega.csv --oled tela.pbm
+//
+// A telemetria serial do firmware vai para --telemetria (padrão /dev/null); o resumo sai no terminal.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_linux.h"
+#include "ssd1306.h"
+#include "matriz_leds.h"
+#include "buzzer.h"
+#include "agenda.h"
+#include "estado.h"
+#include "jardim.h"
+#include "registro.h"
+#include "energia.h"
+#include "perfil.h"
+#include "telemetria.h"
+#include "zonas.h"
+#include "ajustes.h"
+#include "botoes.h"
+#include "agua.h"
+#include "barramento.h"
+
+// Mesmos pinos do Garden.c
+#define Matriz 7
+#define Buzzer 21
+#define Relay 12
+#define Sensor_Vazao 4
+#define Sensor_Nivel 3
+#define Rede_TX 8
+#define Rede_RX 9
+#define Rede_DE 2
+
+// Zonas além da primeira (--zonas): as quatro seguintes no multiplexador, as demais no ADS1115
+static const uint8_t reles_extras[ZONAS_MAX - 1] = {8, 9, 10, 11, 13, 19, 20};
+#define ZONAS_NO_MUX 4
+
+static double segundos_parede(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Toques nos botões: um alarme encadeado faz o papel da interrupção do GPIO no Garden.c, com o
+// ruído de contato de um botão de verdade (três bordas a 0,3 ms uma da outra ao pressionar e ao soltar)
+#define Bot_Left 5
+#define Bot_Right 6
+#define Bot_Confirm 22
+#define RUIDO_US 300
+static const uint8_t pinos_botoes[] = {Bot_Left, Bot_Right, Bot_Confirm}; // Ordem de botao_t
+
+typedef struct {
+  uint64_t t_us;
+  uint8_t pino;
+  bool nivel;
+} borda_sim_t;
+
+static borda_sim_t bordas[64 * 6];
+static int total_bordas, proxima_borda;
+
+// Pressiona o botão (e, d ou c) no instante t e solta depois de duracao segundos
+static bool toque_adicionar(double t, char botao, double duracao) {
+  const char *letras = "edc", *l = strchr(letras, botao);
+  if (!botao || !l || t < 0 || duracao <= 0.001 || total_bordas + 6 > (int)count_of(bordas))
+    return false;
+  uint8_t pino = pinos_botoes[l - letras];
+  uint64_t inicio = t * 1e6, fim = (t + duracao) * 1e6;
+  for (int i = 0; i < 3; ++i) {
+    bordas[total_bordas++] = (borda_sim_t){inicio + i * RUIDO_US, pino, i & 1};
+    bordas[total_bordas++] = (borda_sim_t){fim + i * RUIDO_US, pino, !(i & 1)};
+  }
+  return true;
+}
+
+static int compara_bordas(const void *a, const void *b) {
+  uint64_t ta = ((const borda_sim_t *)a)->t_us, tb = ((const borda_sim_t *)b)->t_us;
+  return (ta > tb) - (ta < tb);
+}
+
+// Linhas digitadas na serial USB (--serial e o --ajustar do coordenador), lidas pelo firmware
+typedef struct {
+  uint64_t t_us;
+  char texto[64];
+} linha_serial_t;
+
+static linha_serial_t linhas_serial[32];
+static int total_linhas_serial;
+
+static bool serial_adicionar(double t, const char *texto) {
+  if (t < 0 || total_linhas_serial >= (int)count_of(linhas_serial) || strlen(texto) + 2 > sizeof linhas_serial[0].texto)
+    return false;
+  linha_serial_t *l = &linhas_serial[total_linhas_serial++];
+  l->t_us = (uint64_t)(t * 1e6);
+  snprintf(l->texto, sizeof l->texto, "%s\n", texto);
+  return true;
+}
+
+static int compara_linhas(const void *a, const void *b) {
+  uint64_t ta = ((const linha_serial_t *)a)->t_us, tb = ((const linha_serial_t *)b)->t_us;
+  return (ta > tb) - (ta < tb);
+}
+
+static int64_t borda(hal_alarme_t id, void *ctx) {
+  uint64_t agora = hal_tempo_us();
+  for (; proxima_borda < total_bordas && bordas[proxima_borda].t_us <= agora; ++proxima_borda) {
+    hal_gpio_put(bordas[proxima_borda].pino, bordas[proxima_borda].nivel);
+    botoes_borda(bordas[proxima_borda].pino, bordas[proxima_borda].nivel);
+  }
+  return proxima_borda < total_bordas ? -(int64_t)(bordas[proxima_borda].t_us - agora) : 0;
+}
+
+static void uso(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções]\n"
+          "  --dias D             tempo simulado (padrão 1)\n"
+          "  --zonas N            vasos/zonas de irrigação, 1-%d (padrão 1)\n"
+          "  --fitas N            fitas ou painéis WS2812 em paralelo, 1-%d (padrão 1)\n"
+          "  --ideal P            umidade ideal em %% (padrão 50)\n"
+          "  --rega S             tempo de rega em s (padrão 5)\n"
+          "  --umidade P          umidade inicial do solo em %% (padrão 45)\n"
+          "  --reservatorio L     água no reservatório em litros (padrão 10)\n"
+          "  --boia L             nível mínimo da boia do reservatório em litros, 0 = sem boia (padrão 0.5)\n"
+          "  --hora H             hora do dia no início (padrão 8)\n"
+          "  --toques T[:B[:S]],... toques nos botões no instante T (s): B = e, d ou c (esquerdo, direito\n"
+          "                       ou confirmação, padrão c), segurado por S s (padrão 0.1)\n"
+          "  --defeito T:C:p|s    sensor no canal C do ADC preso (p) ou solto (s) a partir de T s\n"
+          "  --roteiro ARQ        linhas \"t_s canal valor\" (valor do ADC, 0-4095) no lugar do modelo\n"
+          "  --linha-do-tempo ARQ CSV com as mudanças do relé e do buzzer\n"
+          "  --oled ARQ           memória final do display em PBM\n"
+          "  --rolagem 0|1        rolagem de uma coluna no controlador do display para o gráfico (padrão 0)\n"
+          "  --telemetria ARQ     saída serial do firmware (padrão /dev/null)\n"
+          "  --registro ARQ       exportação final do histórico da flash (ler com ler_registro)\n"
+          "  --flash ARQ          imagem da flash lida no início (se existir) e salva no fim: simula reinícios\n"
+          "  --ajustar P,S        depois do boot, ideal P%% e rega S s em todas as zonas, como pelos botões\n"
+          "                       (com --rede, mandados pelo coordenador; com --coordenar, comandos \"A\" para o nó 1)\n"
+          "  --serial T:LINHA     linha digitada na serial USB no instante T (s), como \"30:A 2 1 60 10\" ou \"60:P\";\n"
+          "                       pode repetir\n"
+          "  --rede N             barramento RS-485 com N nós, 2-%d: o firmware é o nó 1, os demais são virtuais\n"
+          "  --coordenar N        o firmware é o coordenador de N nós virtuais, 1-%d (como Rede_Nos)\n"
+          "  --bombas B           bombas ligadas ao mesmo tempo no orçamento do coordenador (padrão 1)\n",
+          prog, ZONAS_MAX, MATRIZ_FITAS_MAX, REDE_NOS_MAX, REDE_NOS_MAX);
+}
+
+int main(int argc, char **argv) {
+  hal_sim_config_t cfg;
+  hal_sim_config_padrao(&cfg);
+  cfg.pino_buzzer = Buzzer;
+
+  double dias = 1;
+  int ideal_pct = 50, rega_s = 5, total_zonas = 1, fitas = 1, rolagem = 0;
+  const char *arquivo_oled = NULL, *arquivo_linha = NULL, *arquivo_telemetria = "/dev/null";
+  const char *arquivo_registro = NULL, *arquivo_flash = NULL;
+  int ajuste_ideal = -1, ajuste_rega = -1;
+  int rede_nos = 0, coordenados = 0, bombas = 1;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *op = argv[i], *v = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!v) {
+      uso(argv[0]);
+      return 2;
+    }
+    if (!strcmp(op, "--dias")) dias = atof(v);
+    else if (!strcmp(op, "--zonas")) total_zonas = atoi(v);
+    else if (!strcmp(op, "--fitas")) fitas = atoi(v);
+    else if (!strcmp(op, "--ideal")) ideal_pct = atoi(v);
+    else if (!strcmp(op, "--rega")) rega_s = atoi(v);
+    else if (!strcmp(op, "--umidade")) cfg.umidade_inicial = atof(v);
+    else if (!strcmp(op, "--reservatorio")) cfg.reservatorio_l = atof(v);
+    else if (!strcmp(op, "--boia")) cfg.nivel_min_l = atof(v);
+    else if (!strcmp(op, "--hora")) cfg.hora_inicial = atof(v);
+    else if (!strcmp(op, "--roteiro")) cfg.roteiro = v;
+    else if (!strcmp(op, "--defeito")) {
+      int canal;
+      char tipo;
+      if (sscanf(v, "%lf:%d:%c", &cfg.defeito_s, &canal, &tipo) != 3 || (tipo != 'p' && tipo != 's')) {
+        uso(argv[0]);
+        return 2;
+      }
+      cfg.canal_defeito = canal;
+      cfg.defeito = tipo;
+    }
+    else if (!strcmp(op, "--toques")) {
+      for (char *p = (char *)v; *p; ++p) {
+        double t = strtod(p, &p), duracao = 0.1;
+        char botao = 'c';
+        if (*p == ':') {
+          botao = p[1];
+          p += botao ? 2 : 1;
+        }
+        if (*p == ':')
+          duracao = strtod(p + 1, &p);
+        if (!toque_adicionar(t, botao, duracao)) {
+          uso(argv[0]);
+          return 2;
+        }
+        if (*p != ',')
+          break;
+      }
+    }
+    else if (!strcmp(op, "--serial")) {
+      char *texto;
+      double t = strtod(v, &texto);
+      if (*texto != ':' || !serial_adicionar(t, texto + 1)) {
+        uso(argv[0]);
+        return 2;
+      }
+    }
+    else if (!strcmp(op, "--linha-do-tempo")) arquivo_linha = v;
+    else if (!strcmp(op, "--oled")) arquivo_oled = v;
+    else if (!strcmp(op, "--rolagem")) rolagem = atoi(v);
+    else if (!strcmp(op, "--telemetria")) arquivo_telemetria = v;
+    else if (!strcmp(op, "--registro")) arquivo_registro = v;
+    else if (!strcmp(op, "--flash")) arquivo_flash = v;
+    else if (!strcmp(op, "--ajustar")) sscanf(v, "%d,%d", &ajuste_ideal, &ajuste_rega);
+    else if (!strcmp(op, "--rede")) rede_nos = atoi(v);
+    else if (!strcmp(op, "--coordenar")) coordenados = atoi(v);
+    else if (!strcmp(op, "--bombas")) bombas = atoi(v);
+    else {
+      uso(argv[0]);
+      return 2;
+    }
+    ++i;
+  }
+
+  if (total_zonas < 1 || total_zonas > ZONAS_MAX || fitas < 1 || fitas > MATRIZ_FITAS_MAX || rede_nos == 1 ||
+      rede_nos < 0 || rede_nos > REDE_NOS_MAX || coordenados < 0 || coordenados > REDE_NOS_MAX ||
+      (rede_nos && coordenados) || bombas < 1) {
+    uso(argv[0]);
+    return 2;
+  }
+
+  // A mesma tabela do Garden.c, montada para o número de zonas pedido, e a fiação equivalente no modelo
+  static char nomes[ZONAS_MAX][12];
+  zona_config_t tabela[ZONAS_MAX];
+  tabela[0] = (zona_config_t){"Vaso", ZONA_ADC, SENSOR_CANAL_UMIDADE, Relay, ideal_pct, rega_s};
+  cfg.vasos = total_zonas;
+  cfg.vaso[0] = (hal_sim_vaso_t){Relay, -1, -1};
+  for (int z = 1; z < total_zonas; ++z) {
+    bool no_mux = z <= ZONAS_NO_MUX;
+    uint8_t canal = no_mux ? z - 1 : z - 1 - ZONAS_NO_MUX;
+    snprintf(nomes[z], sizeof nomes[z], "Vaso %d", z + 1);
+    tabela[z] = (zona_config_t){nomes[z], no_mux ? ZONA_MUX : ZONA_I2C, canal, reles_extras[z - 1], ideal_pct, rega_s};
+    cfg.vaso[z] = (hal_sim_vaso_t){reles_extras[z - 1], no_mux ? canal : -1, no_mux ? -1 : canal};
+  }
+
+  cfg.pino_nivel = cfg.nivel_min_l > 0 ? Sensor_Nivel : -1;
+
+  if (arquivo_linha && !(cfg.linha_do_tempo = fopen(arquivo_linha, "w"))) {
+    perror(arquivo_linha);
+    return 1;
+  }
+  if (!hal_sim_iniciar(&cfg)) {
+    perror(cfg.roteiro);
+    return 1;
+  }
+  if (arquivo_flash)
+    hal_sim_carregar_flash(arquivo_flash); // Sem o arquivo, a flash começa apagada
+
+  // A telemetria do firmware sai por printf; o resumo usa uma cópia do terminal original
+  fflush(stdout);
+  int terminal = dup(STDOUT_FILENO);
+  if (!freopen(arquivo_telemetria, "w", stdout)) {
+    perror(arquivo_telemetria);
+    return 1;
+  }
+
+  // Mesma sequência de inicialização do Garden.c
+  ssd1306_t ssd;
+  for (size_t i = 0; i < count_of(pinos_botoes); ++i)
+    hal_gpio_put(pinos_botoes[i], true); // Pull-up: solto
+  botoes_init(pinos_botoes, count_of(pinos_botoes));
+  agua_init(Sensor_Vazao, cfg.pino_nivel);
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+  ssd.column_scroll = rolagem;
+  matriz_leds_init(Matriz, fitas);
+  buzzer_init(Buzzer);
+  jardim_init(&ssd, tabela, total_zonas);
+  if (rede_nos) {
+    hal_uart_init(REDE_BAUD, Rede_TX, Rede_RX, Rede_DE);
+    jardim_rede(1);
+    barramento_iniciar(&(barramento_config_t){.nos = rede_nos, .firmware = true, .bombas_max = bombas, .zonas = 2,
+                                              .baud = REDE_BAUD});
+  } else if (coordenados) {
+    hal_uart_init(REDE_BAUD, Rede_TX, Rede_RX, Rede_DE);
+    jardim_coordenar(coordenados, bombas);
+    barramento_iniciar(&(barramento_config_t){.nos = coordenados, .firmware = true, .bombas_max = bombas, .zonas = 2,
+                                              .baud = REDE_BAUD, .coordenador = jardim_coordenador()});
+  }
+  ssd1306_config(&ssd);
+  if (ajuste_ideal >= 0 && rede_nos) {
+    for (int z = 0; z < total_zonas; ++z)
+      rede_coord_ajustar(barramento_coordenador(), 1, z, ajuste_ideal, ajuste_rega >= 5 ? ajuste_rega : tempo_rega[z]);
+  } else if (ajuste_ideal >= 0 && coordenados) {
+    for (int z = 1; z <= 2; ++z) { // Pelo comando "A" da serial, nas duas zonas do nó virtual 1
+      char comando[32];
+      snprintf(comando, sizeof comando, "A 1 %d %d %d", z, ajuste_ideal, ajuste_rega >= 5 ? ajuste_rega : 5);
+      serial_adicionar(hal_tempo_us() / 1e6, comando);
+    }
+  } else if (ajuste_ideal >= 0) {
+    for (int z = 0; z < total_zonas; ++z) {
+      ideal[z] = ajuste_ideal;
+      if (ajuste_rega >= 5)
+        tempo_rega[z] = ajuste_rega;
+    }
+  }
+  qsort(linhas_serial, total_linhas_serial, sizeof linhas_serial[0], compara_linhas);
+  for (int i = 0; i < total_linhas_serial; ++i)
+    hal_sim_serial_digitar(linhas_serial[i].texto, linhas_serial[i].t_us);
+  if (total_bordas) {
+    qsort(bordas, total_bordas, sizeof bordas[0], compara_bordas);
+    hal_alarme_em_ms(bordas[0].t_us / 1000, borda, NULL);
+  }
+
+  // Os dois "núcleos" se alternam: tarefas vencidas (ou sono até o próximo prazo) e um passo da interface
+  uint64_t fim_us = (uint64_t)(dias * 86400e6);
+  double t0 = segundos_parede();
+  while (hal_tempo_us() < fim_us) {
+    jardim_controle();
+    jardim_interface();
+  }
+  double parede = segundos_parede() - t0;
+  ssd1306_send_data(&ssd); // Colunas ainda marcadas saem antes de comparar a memória do display
+
+  // Mesma exportação que o comando "D" da serial produz na placa
+  fflush(stdout);
+  if (arquivo_registro) {
+    if (!freopen(arquivo_registro, "wb", stdout)) {
+      perror(arquivo_registro);
+      return 1;
+    }
+    registro_exportar();
+    fflush(stdout);
+  }
+  dup2(terminal, STDOUT_FILENO);
+  close(terminal);
+
+  const hal_sim_estatisticas_t *e = hal_sim_estatisticas();
+  double simulado = hal_tempo_us() / 1e6;
+  printf("Tempo simulado: %.0f s (%.2f dias) em %.3f s de parede, %.0fx o tempo real\n",
+         simulado, simulado / 86400, parede, simulado / parede);
+  printf("Regas: %lu, bomba ligada %.1f s, %.1f s com o reservatório vazio (restam %.2f L)\n",
+         (unsigned long)irrigacao_regas(&rega), irrigacao_bomba_total_us(&rega) / 1e6, e->bomba_seca_us / 1e6, e->reservatorio_l);
+  printf("Água: %.2f L bombeados, %lu regas cortadas a seco\n", e->bombeado_l, (unsigned long)agua_secas());
+  printf("Acionamentos do relé: %lu, tons do buzzer: %lu, alarmes disparados: %lu\n",
+         (unsigned long)e->acionamentos_rele, (unsigned long)e->tons_buzzer, (unsigned long)e->alarmes_disparados);
+  printf("Umidade real do solo: min %.1f%%, max %.1f%%, final", e->umidade_min, e->umidade_max);
+  for (int z = 0; z < total_zonas; ++z)
+    printf(" %.1f%%", hal_sim_umidade(z));
+  printf("\n");
+  printf("Relés ligados ao mesmo tempo: %.1f s, leituras do ADC I2C: %lu (%lu falhas)\n",
+         e->sobreposicao_us / 1e6, (unsigned long)e->leituras_i2c, (unsigned long)zonas_falhas_i2c());
+  printf("I2C: %llu bytes em %lu transações, barramento ocupado %.2f%% do tempo\n",
+         (unsigned long long)e->i2c_bytes, (unsigned long)e->i2c_transacoes,
+         100.0 * e->i2c_ocupado_us / hal_tempo_us());
+  printf("Display: %lu bytes da memória diferentes do buffer do driver\n",
+         (unsigned long)hal_sim_oled_diferencas(ssd.ram_buffer));
+  printf("Quadros enviados à matriz de LEDs: %lu (%d fita%s, %.0f us cada), retratos descartados: %lu\n",
+         (unsigned long)e->quadros_leds, fitas, fitas > 1 ? "s" : "",
+         e->quadros_leds ? (double)e->leds_ocupado_us / e->quadros_leds : 0.0, (unsigned long)estado_descartados());
+  printf("Flash: %lu setores apagados, %lu páginas gravadas, %lu amostras do histórico perdidas\n",
+         (unsigned long)e->flash_apagamentos, (unsigned long)e->flash_programacoes,
+         (unsigned long)registro_perdidas());
+  printf("Trocas do relógio do sistema: %lu\n", (unsigned long)e->trocas_relogio);
+  printf("Boot: %.1f ms até a primeira decisão de rega; ajustes %s (ideal %d%%, rega %d s), %lu gravações\n",
+         jardim_boot_us() / 1e3, ajustes_carregados() ? "da flash" : "da tabela", ideal[0], tempo_rega[0],
+         (unsigned long)ajustes_gravacoes());
+  printf("Botões: %lu bordas, %lu eventos, %lu bordas descartadas\n", (unsigned long)botoes_bordas(),
+         (unsigned long)botoes_eventos(), (unsigned long)botoes_descartadas());
+  printf("Telemetria: %lu quadros, %lu descartados\n", (unsigned long)telemetria_quadros(),
+         (unsigned long)telemetria_descartados());
+  agenda_relatorio();
+  irrigacao_relatorio(&rega);
+  agua_relatorio();
+  energia_relatorio();
+  jardim_relatorio_sensores();
+  if (rede_nos || coordenados)
+    barramento_relatorio();
+#if PERFIL_ATIVO
+  perfil_relatorio(); // Nanossegundos reais do host por etapa
+#endif
+
+  if (cfg.linha_do_tempo)
+    fclose(cfg.linha_do_tempo);
+  if (arquivo_flash && !hal_sim_salvar_flash(arquivo_flash)) {
+    perror(arquivo_flash);
+    return 1;
+  }
+  if (arquivo_oled && !hal_sim_salvar_oled(arquivo_oled)) {
+    perror(arquivo_oled);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,97 @@
+// Rede RS-485 de várias placas em um único processo: o coordenador de rede.h e nós virtuais no
+// barramento simulado (barramento.c), sobre o relógio virtual de hal_linux. Mede o tempo de um ciclo
+// de consultas conforme cresce o número de nós e confere o orçamento de bombas e os ajustes remotos.
+//
+//   ./sim_rede                        # 1, 2, 4, 8, 16 e 32 nós, 1 h simulada cada
+//   ./sim_rede --nos 8 --bombas 2 --erro 200 --relatorio
+//
+// Com o firmware no barramento, ver sim_garden --rede.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_linux.h"
+#include "barramento.h"
+
+#define AJUSTE_IDEAL 60 // Mandado a todas as zonas no início; confirmado pelos retratos
+#define AJUSTE_REGA 10
+
+static void uso(const char *prog) {
+  fprintf(stderr,
+          "uso: %s [opções]\n"
+          "  --nos N        só N nós, 1-%d (padrão: 1, 2, 4, 8, 16 e 32)\n"
+          "  --zonas Z      zonas de cada nó, 1-%d (padrão 2)\n"
+          "  --bombas B     bombas ligadas ao mesmo tempo no orçamento (padrão 1)\n"
+          "  --horas H      tempo simulado por rodada (padrão 1)\n"
+          "  --erro PPM     bytes trocados na linha, por milhão (padrão 0)\n"
+          "  --baud B       taxa da UART (padrão %d)\n"
+          "  --relatorio    estado de cada nó no fim de cada rodada\n",
+          prog, REDE_NOS_MAX, ZONAS_MAX, REDE_BAUD);
+}
+
+int main(int argc, char **argv) {
+  barramento_config_t rede = {.zonas = 2, .bombas_max = 1, .baud = REDE_BAUD};
+  double horas = 1;
+  int nos_unico = 0;
+  bool relatorio = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *op = argv[i], *v = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!strcmp(op, "--relatorio")) {
+      relatorio = true;
+      continue;
+    }
+    if (!v) {
+      uso(argv[0]);
+      return 2;
+    }
+    if (!strcmp(op, "--nos")) nos_unico = atoi(v);
+    else if (!strcmp(op, "--zonas")) rede.zonas = atoi(v);
+    else if (!strcmp(op, "--bombas")) rede.bombas_max = atoi(v);
+    else if (!strcmp(op, "--horas")) horas = atof(v);
+    else if (!strcmp(op, "--erro")) rede.erro_ppm = atoi(v);
+    else if (!strcmp(op, "--baud")) rede.baud = atoi(v);
+    else {
+      uso(argv[0]);
+      return 2;
+    }
+    ++i;
+  }
+  if (nos_unico < 0 || nos_unico > REDE_NOS_MAX || rede.zonas < 1 || rede.zonas > ZONAS_MAX || !rede.baud) {
+    uso(argv[0]);
+    return 2;
+  }
+
+  static const uint8_t varredura[] = {1, 2, 4, 8, 16, 32};
+  printf("%5s %10s %10s %10s %11s %8s %8s %6s %7s %9s %8s\n", "nós", "ciclo_med", "ciclo_max", "por_nó", "ocupação",
+         "sem_resp", "corromp", "regas", "bombas", "acima_s", "ajustes");
+  for (size_t k = 0; k < count_of(varredura); ++k) {
+    rede.nos = nos_unico ? nos_unico : varredura[k];
+    hal_sim_config_t sim;
+    hal_sim_config_padrao(&sim);
+    hal_sim_iniciar(&sim);
+    barramento_iniciar(&rede);
+    rede_coord_t *c = barramento_coordenador();
+    for (uint8_t e = 1; e <= rede.nos; ++e)
+      for (uint8_t z = 0; z < rede.zonas; ++z)
+        rede_coord_ajustar(c, e, z, AJUSTE_IDEAL, AJUSTE_REGA);
+
+    uint64_t fim_us = horas * 3600e6;
+    while (hal_tempo_us() < fim_us)
+      hal_dormir();
+
+    const barramento_estatisticas_t *e = barramento_estatisticas();
+    uint32_t sem_resposta = 0;
+    for (uint8_t i = 0; i < c->nos; ++i)
+      sem_resposta += c->no[i].sem_resposta;
+    double medio_ms = c->ciclos ? c->ciclo_soma_us / 1e3 / c->ciclos : 0;
+    printf("%4u %7.2f ms %7.2f ms %6.2f ms %8.1f%% %8lu %8lu %6lu %3u/%-3u %9.1f %5u/%-2u\n", rede.nos, medio_ms,
+           c->ciclo_max_us / 1e3, medio_ms / rede.nos, 100.0 * e->ocupado_us / hal_tempo_us(), (unsigned long)sem_resposta,
+           (unsigned long)c->corrompidos, (unsigned long)e->regas_virtuais, e->bombas_max, rede.bombas_max, e->acima_us / 1e6,
+           rede.nos - barramento_ajustes_pendentes(), rede.nos);
+    if (relatorio)
+      barramento_relatorio();
+    if (nos_unico)
+      break;
+  }
+  return 0;
+}